@@ -0,0 +1,45 @@
+#version 450 core
+
+// Vertex shader for InstanceFormat::Compact (RenderInstance::Compact).
+// Pair with default.frag, and create the shader via IResourceFactory::create_shader(vert, frag, InstanceFormat::Compact).
+// The default shader draws compact instances with this variant (embedded as spirv::compact_vert()).
+
+struct Instance {
+	vec4 linear;
+	vec2 translation;
+	uint tint;
+	uint padding;
+};
+
+layout (location = 0) in vec2 a_pos;
+layout (location = 1) in vec4 a_color;
+layout (location = 2) in vec2 a_uv;
+
+layout (location = 0) out vec4 out_tint;
+layout (location = 1) out vec2 out_uv;
+
+layout (set = 0, binding = 0) uniform View {
+  mat4 mat_view;
+  mat4 mat_proj;
+};
+
+layout (set = 1, binding = 0) readonly buffer Instances {
+	Instance instances[];
+};
+
+vec4 srgb_to_linear(const vec4 srgb) {
+	const vec3 low = srgb.rgb / 12.92;
+	const vec3 high = pow((srgb.rgb + 0.055) / 1.055, vec3(2.4));
+	return vec4(mix(high, low, lessThanEqual(srgb.rgb, vec3(0.04045))), srgb.a);
+}
+
+void main() {
+	const Instance instance = instances[gl_InstanceIndex];
+
+	out_uv = a_uv;
+	out_tint = a_color * srgb_to_linear(unpackUnorm4x8(instance.tint));
+
+	const mat2 linear = mat2(instance.linear.xy, instance.linear.zw);
+	const vec4 world_pos = vec4(linear * a_pos + instance.translation, 0.0, 1.0);
+	gl_Position = mat_proj * mat_view * world_pos;
+}
@@ -0,0 +1,51 @@
+#version 450 core
+
+// Vertex shader for InstanceFormat::Glyph (GlyphInstance): expands each instance into a 4 vertex triangle strip, without vertex input.
+// The draw's RenderInstances are read from set 1, binding 2: each one is drawn with its own first vertex (4 per instance).
+// Pair with default.frag, or sdf.frag (distance field atlases).
+// The default shader draws Primitive::glyphs with this variant (embedded as spirv::glyph_vert()).
+
+struct Instance {
+	mat4 mat_world;
+	vec4 tint;
+};
+
+struct Glyph {
+	vec2 lt;
+	vec2 rb;
+	uvec2 uv;
+	uint color;
+	uint padding;
+};
+
+layout (location = 0) out vec4 out_tint;
+layout (location = 1) out vec2 out_uv;
+
+layout (set = 0, binding = 0) uniform View {
+  mat4 mat_view;
+  mat4 mat_proj;
+};
+
+layout (set = 1, binding = 0) readonly buffer Glyphs {
+	Glyph glyphs[];
+};
+
+layout (set = 1, binding = 2) readonly buffer Instances {
+	Instance instances[];
+};
+
+void main() {
+	const Glyph glyph = glyphs[gl_InstanceIndex];
+	const Instance instance = instances[gl_VertexIndex >> 2];
+	// strip order: left-bottom, right-bottom, left-top, right-top.
+	const int strip_index = gl_VertexIndex & 3;
+	const vec2 corner = vec2(strip_index & 1, strip_index >> 1);
+
+	const vec2 uv_lt = unpackUnorm2x16(glyph.uv.x);
+	const vec2 uv_rb = unpackUnorm2x16(glyph.uv.y);
+	out_uv = mix(vec2(uv_lt.x, uv_rb.y), vec2(uv_rb.x, uv_lt.y), corner);
+	out_tint = unpackUnorm4x8(glyph.color) * instance.tint;
+
+	const vec2 position = mix(vec2(glyph.lt.x, glyph.rb.y), vec2(glyph.rb.x, glyph.lt.y), corner);
+	gl_Position = mat_proj * mat_view * instance.mat_world * vec4(position, 0.0, 1.0);
+}
@@ -0,0 +1,17 @@
+#version 450 core
+
+// Fragment shader for signed distance fields in alpha (ITextureBase::is_distance_field()), eg distance field font atlases.
+// Edges are at 0.5: coverage is reconstructed over about a screen pixel, at any scale.
+
+layout (set = 1, binding = 1) uniform sampler2D tex;
+
+layout (location = 0) in vec4 in_tint;
+layout (location = 1) in vec2 in_uv;
+
+layout (location = 0) out vec4 out_color;
+
+void main() {
+	const float distance = texture(tex, in_uv).a;
+	const float width = max(0.5 * fwidth(distance), 1.0 / 255.0);
+	out_color = in_tint * vec4(1.0, 1.0, 1.0, smoothstep(0.5 - width, 0.5 + width, distance));
+}
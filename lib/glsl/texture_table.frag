@@ -0,0 +1,17 @@
+#version 450 core
+#extension GL_EXT_nonuniform_qualifier : require
+
+// Fragment shader for batches drawn through a texture table, see texture_table.vert.
+// Requires shaderSampledImageArrayNonUniformIndexing: the index varies across a draw.
+
+layout (set = 3, binding = 1) uniform sampler2D textures[16];
+
+layout (location = 0) in vec4 in_tint;
+layout (location = 1) in vec2 in_uv;
+layout (location = 2) flat in uint in_texture;
+
+layout (location = 0) out vec4 out_color;
+
+void main() {
+	out_color = in_tint * texture(textures[nonuniformEXT(in_texture)], in_uv);
+}
@@ -0,0 +1,42 @@
+#version 450 core
+
+// Vertex shader for batches drawn through a texture table (a descriptor-indexed array of textures in set 3).
+// Pair with texture_table.frag, the renderer uses this variant when IRenderer::merge_textures is set (embedded as spirv::texture_table_vert()).
+// Batch vertices are indexed from zero, so gl_VertexIndex locates each vertex's entry in TextureIndices.
+
+struct Instance {
+	mat4 mat_world;
+	vec4 tint;
+};
+
+layout (location = 0) in vec2 a_pos;
+layout (location = 1) in vec4 a_color;
+layout (location = 2) in vec2 a_uv;
+
+layout (location = 0) out vec4 out_tint;
+layout (location = 1) out vec2 out_uv;
+layout (location = 2) flat out uint out_texture;
+
+layout (set = 0, binding = 0) uniform View {
+  mat4 mat_view;
+  mat4 mat_proj;
+};
+
+layout (set = 1, binding = 0) readonly buffer Instances {
+	Instance instances[];
+};
+
+layout (set = 3, binding = 0) readonly buffer TextureIndices {
+	uint texture_indices[];
+};
+
+void main() {
+	const Instance instance = instances[gl_InstanceIndex];
+
+	out_uv = a_uv;
+	out_tint = a_color * instance.tint;
+	out_texture = texture_indices[gl_VertexIndex];
+
+	const vec4 world_pos = instance.mat_world * vec4(a_pos, 0.0, 1.0);
+	gl_Position = mat_proj * mat_view * world_pos;
+}
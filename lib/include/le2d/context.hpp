@@ -194,6 +194,8 @@ class Context : public klib::Polymorphic {
 	virtual void present() = 0;
 
 	[[nodiscard]] virtual auto get_frame_stats() const -> FrameStats const& = 0;
+	/// \returns GPU timings of the primary RenderPass (requires IRenderer::gpu_timestamps).
+	[[nodiscard]] virtual auto get_gpu_timings() const -> std::span<GpuTiming const> = 0;
 
 	[[nodiscard]] auto create_waiter() -> Waiter;
 	[[nodiscard]] virtual auto create_render_pass(vk::SampleCountFlagBits samples) const -> std::unique_ptr<IRenderPass> = 0;
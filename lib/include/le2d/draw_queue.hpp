@@ -0,0 +1,68 @@
+#pragma once
+#include "le2d/primitive_store.hpp"
+#include "le2d/renderer.hpp"
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace le {
+/// \brief Sort key for a queued draw.
+struct DrawKey {
+	/// \brief Primary ordering: lower layers are drawn first.
+	std::int16_t layer{};
+	/// \brief Final tie-breaker within a layer: lower depths are drawn first.
+	float depth{};
+	/// \brief Shader to draw with, null means the IRenderer's shader when replayed.
+	klib::Ptr<IShader const> shader{};
+};
+
+/// \brief Deferred draw submissions sorted by (layer, shader, texture, depth).
+/// Primitives and instances are copied on submission, so sources need not outlive the call.
+/// Sorting is stable: draws with identical keys are replayed in submission order.
+/// Draws within a layer may be reordered to group state, use distinct layers where blending order matters.
+class DrawQueue {
+  public:
+	/// \brief Queue given instances of a Primitive.
+	/// \param primitive Primitive to draw.
+	/// \param instances Render Instances to draw (will be baked).
+	/// \param key Sort key.
+	void submit(Primitive const& primitive, std::span<RenderInstance const> instances, DrawKey const& key = {});
+	/// \brief Queue given instances of a Primitive.
+	/// \param primitive Primitive to draw.
+	/// \param instances Render Instances to draw (pre-baked).
+	/// \param key Sort key.
+	void submit_baked(Primitive const& primitive, std::span<RenderInstance::Std430 const> instances, DrawKey const& key = {});
+
+	/// \brief Sort queued draws, replay them through renderer, and clear the queue.
+	/// The renderer's shader is restored after replay, other state is used as-is.
+	/// \param renderer Renderer to draw with.
+	void flush(IRenderer& renderer);
+	/// \brief Discard all queued draws.
+	void clear();
+
+	[[nodiscard]] auto get_size() const -> std::size_t { return m_entries.size(); }
+	[[nodiscard]] auto is_empty() const -> bool { return m_entries.empty(); }
+
+  private:
+	struct Entry {
+		PrimitiveStore::Entry draw{};
+		DrawKey key{};
+	};
+
+	struct Sortable {
+		std::uint64_t key{};
+		std::uint32_t index{};
+	};
+
+	void sort(IShader const& fallback);
+
+	std::vector<Entry> m_entries{};
+	PrimitiveStore m_store{};
+
+	std::vector<Sortable> m_sorted{};
+	std::vector<Sortable> m_scratch{};
+	std::unordered_map<void const*, std::uint32_t> m_shader_ids{};
+	std::unordered_map<void const*, std::uint32_t> m_texture_ids{};
+};
+} // namespace le
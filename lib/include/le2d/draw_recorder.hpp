@@ -0,0 +1,48 @@
+#pragma once
+#include "le2d/primitive_store.hpp"
+#include "le2d/renderer.hpp"
+#include <cstdint>
+#include <span>
+#include <variant>
+#include <vector>
+
+namespace le {
+/// \brief Recorded draw submissions, replayed in order through an IRenderer.
+/// This is a CPU-side draw list, not a secondary command buffer: no Vulkan commands are recorded until replay() runs on the render thread.
+/// Primitives and instances are copied (and baked) on submission, so sources need not outlive the call.
+/// Distinct recorders share no state: each may be filled on a different thread concurrently.
+class DrawRecorder {
+  public:
+	/// \brief Record a view change.
+	void set_view(Transform const& view);
+	/// \brief Record a shader change.
+	void set_shader(IShader const& shader);
+	/// \brief Record a scissor rect change.
+	void set_scissor_rect(kvf::UvRect const& rect);
+
+	/// \brief Record given instances of a Primitive.
+	/// \param primitive Primitive to draw.
+	/// \param instances Render Instances to draw (baked on the calling thread).
+	void draw(Primitive const& primitive, std::span<RenderInstance const> instances);
+	/// \brief Record given instances of a Primitive.
+	/// \param primitive Primitive to draw.
+	/// \param instances Render Instances to draw (pre-baked).
+	void draw_baked(Primitive const& primitive, std::span<RenderInstance::Std430 const> instances);
+
+	/// \brief Replay recorded commands through renderer.
+	/// The renderer's view, shader, and scissor rect are restored afterwards.
+	/// \param renderer Renderer to draw with.
+	void replay(IRenderer& renderer) const;
+	/// \brief Discard all recorded commands, retaining storage.
+	void clear();
+
+	[[nodiscard]] auto get_size() const -> std::size_t { return m_commands.size(); }
+	[[nodiscard]] auto is_empty() const -> bool { return m_commands.empty(); }
+
+  private:
+	using Command = std::variant<PrimitiveStore::Entry, Transform, IShader const*, kvf::UvRect>;
+
+	std::vector<Command> m_commands{};
+	PrimitiveStore m_store{};
+};
+} // namespace le
@@ -1,5 +1,6 @@
 #pragma once
 #include "le2d/geometry.hpp"
+#include "le2d/resource/geometry_buffer.hpp"
 
 namespace le {
 /// \brief Interface for draw primitives (geometry and texture).
@@ -7,6 +8,14 @@ class IDrawPrimitive : public klib::Polymorphic {
   public:
 	[[nodiscard]] virtual auto get_geometry() const -> IGeometry const& = 0;
 	[[nodiscard]] virtual auto get_texture() const -> klib::Ptr<ITextureBase const> = 0;
+	/// \returns Retained geometry to draw instead of get_geometry(), if any.
+	[[nodiscard]] virtual auto get_geometry_buffer() const -> klib::Ptr<IGeometryBuffer const> { return {}; }
+
+	[[nodiscard]] auto to_primitive() const -> Primitive {
+		auto ret = get_geometry().to_primitive(get_texture());
+		ret.geometry_buffer = get_geometry_buffer();
+		return ret;
+	}
 };
 
 /// \brief Concrete draw primitive storing GeometryT and pointer to texture.
@@ -15,8 +24,11 @@ class DrawGeometry : public IDrawPrimitive {
   public:
 	[[nodiscard]] auto get_geometry() const -> IGeometry const& final { return geometry; }
 	[[nodiscard]] auto get_texture() const -> klib::Ptr<ITextureBase const> final { return texture; }
+	[[nodiscard]] auto get_geometry_buffer() const -> klib::Ptr<IGeometryBuffer const> final { return geometry_buffer; }
 
 	GeometryT geometry{};
 	klib::Ptr<ITextureBase const> texture{};
+	/// \brief Optional retained copy of geometry (eg written via IGeometryBuffer::write(geometry)).
+	klib::Ptr<IGeometryBuffer const> geometry_buffer{};
 };
 } // namespace le
@@ -31,6 +31,11 @@ class SpriteBase : public IDrawPrimitive {
 	[[nodiscard]] auto get_resize_aspect() const -> kvf::ResizeAspect { return m_aspect; }
 	void set_resize_aspect(kvf::ResizeAspect aspect);
 
+	/// \returns Format the quad's vertices are stored in.
+	[[nodiscard]] auto get_vertex_format() const -> VertexFormat { return m_quad.get_vertex_format(); }
+	/// \brief Store (and upload) packed vertices, see shape::IQuad::set_vertex_format().
+	void set_vertex_format(VertexFormat const format) { m_quad.set_vertex_format(format); }
+
   protected:
 	void update(glm::vec2 base_size, glm::vec2 origin, kvf::UvRect const& uv);
 
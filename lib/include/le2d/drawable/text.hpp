@@ -2,6 +2,9 @@
 #include "le2d/drawable/draw_instance.hpp"
 #include "le2d/resource/font.hpp"
 #include "le2d/text/text_geometry.hpp"
+#include "le2d/text/text_layout_cache.hpp"
+#include <optional>
+#include <string>
 
 namespace le::drawable {
 /// \brief Horizontal text expansion.
@@ -11,6 +14,13 @@ enum class TextExpand : std::int8_t { eBoth, eRight, eLeft };
 struct TextParams {
 	TextHeight height{TextHeight::Default};
 	TextExpand expand{TextExpand::eBoth};
+	/// \brief Multiplier for height.
+	float scale{1.0f};
+	/// \brief Scale the font's distance field atlas (IFont::get_scaled_atlas()) instead of building an atlas for the exact height.
+	/// Suited to animated or many distinct text sizes.
+	bool distance_field{false};
+	/// \brief Layout cache shared across drawables (optional).
+	klib::Ptr<TextLayoutCache> layout_cache{};
 };
 
 /// \brief Base class for Text types.
@@ -30,6 +40,19 @@ class TextBase : public IDrawPrimitive {
 	std::vector<kvf::ttf::GlyphLayout> m_glyph_layouts{};
 	klib::Ptr<ITexture const> m_texture{};
 	glm::vec2 m_size{};
+
+	// identifies an atlas without relying on its address, which may be reused after a font's atlases are rebuilt.
+	struct AtlasKey {
+		std::uint64_t generation{};
+		TextHeight height{};
+
+		auto operator==(AtlasKey const&) const -> bool = default;
+	};
+
+	// inputs of the current geometry, to skip rebuilding for the same string.
+	std::optional<AtlasKey> m_atlas_key{};
+	std::string m_line{};
+	Params m_params{};
 };
 
 /// \brief Text drawable.
@@ -1,6 +1,8 @@
 #pragma once
 #include "kvf/time.hpp"
+#include <chrono>
 #include <cstdint>
+#include <string>
 
 namespace le {
 enum struct Framerate : std::int32_t {};
@@ -12,4 +14,12 @@ struct FrameStats {
 	Framerate framerate{};
 	std::uint64_t total_frames{};
 };
+
+/// \brief GPU duration of a render pass or labelled draw group, measured via timestamp queries.
+struct GpuTiming {
+	std::string label{};
+	std::chrono::nanoseconds duration{};
+	/// \brief Nesting level: 0 for the render pass, 1+ for draw groups within it.
+	std::int32_t depth{};
+};
 } // namespace le
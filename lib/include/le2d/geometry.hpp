@@ -3,6 +3,7 @@
 #include "klib/ptr.hpp"
 #include "le2d/primitive.hpp"
 #include "le2d/vertex.hpp"
+#include "le2d/vertex_bounds.hpp"
 #include <vulkan/vulkan.hpp>
 #include <cstdint>
 
@@ -17,11 +18,26 @@ class IGeometry : public klib::Polymorphic {
 	[[nodiscard]] virtual auto get_vertices() const -> std::span<Vertex const> = 0;
 	[[nodiscard]] virtual auto get_indices() const -> std::span<std::uint32_t const> = 0;
 	[[nodiscard]] virtual auto get_topology() const -> vk::PrimitiveTopology = 0;
+	/// \returns Packed vertices to upload instead of get_vertices(), if any (get_vertices() is then empty).
+	[[nodiscard]] virtual auto get_packed_vertices() const -> std::span<PackedVertex const> { return {}; }
+	/// \returns Glyph quads to draw instead of vertices and indices, if any (see Primitive::glyphs).
+	[[nodiscard]] virtual auto get_glyphs() const -> std::span<GlyphInstance const> { return {}; }
+	/// \returns Bounds of the vertices in model space, cached by geometry that is costly to traverse.
+	[[nodiscard]] virtual auto get_local_bounds() const -> kvf::Rect<> { return geometry_bounds(glm::mat4{1.0f}); }
+
+	/// \returns Bounds of the vertices (or glyphs) transformed by model.
+	[[nodiscard]] auto geometry_bounds(glm::mat4 const& model) const -> kvf::Rect<> {
+		if (!get_glyphs().empty()) { return vertex_bounds(get_glyphs(), model); }
+		if (get_vertices().empty()) { return vertex_bounds(get_packed_vertices(), model); }
+		return vertex_bounds(get_vertices(), model);
+	}
 
 	[[nodiscard]] auto to_primitive(klib::Ptr<ITextureBase const> texture) const -> Primitive {
 		return Primitive{
 			.vertices = get_vertices(),
+			.packed_vertices = get_packed_vertices(),
 			.indices = get_indices(),
+			.glyphs = get_glyphs(),
 			.topology = get_topology(),
 			.texture = texture,
 		};
@@ -0,0 +1,54 @@
+#pragma once
+#include "kvf/color.hpp"
+#include "kvf/rect.hpp"
+#include "le2d/vertex.hpp"
+#include <glm/ext/vector_uint4_sized.hpp>
+#include <array>
+#include <cstdint>
+
+namespace le {
+/// \brief Instance data for a single glyph, drawn as a unit quad stretched over rect by the vertex shader (see lib/glsl/glyph.vert).
+/// UVs are quantized to 16 bits and the color to 8 bits per channel (in linear space), like PackedVertex.
+struct GlyphInstance {
+	static constexpr std::size_t vertex_count_v{4};
+
+	/// \brief Left-top corner of the quad.
+	glm::vec2 lt{};
+	/// \brief Right-bottom corner of the quad.
+	glm::vec2 rb{};
+	/// \brief UV rect: (lt.x, lt.y, rb.x, rb.y).
+	glm::u16vec4 uv{};
+	glm::u8vec4 color{0xff};
+	std::uint32_t padding{};
+
+	[[nodiscard]] static auto create(kvf::Rect<> const& rect, kvf::UvRect const& uv, kvf::Color const color = kvf::white_v) -> GlyphInstance {
+		return GlyphInstance{
+			.lt = rect.lt,
+			.rb = rect.rb,
+			.uv = glm::u16vec4(glm::clamp(glm::vec4{uv.lt, uv.rb}, 0.0f, 1.0f) * 65535.0f + 0.5f),
+			.color = glm::u8vec4(glm::clamp(color.to_linear(), 0.0f, 1.0f) * 255.0f + 0.5f),
+		};
+	}
+
+	[[nodiscard]] auto get_rect() const -> kvf::Rect<> { return kvf::Rect<>{.lt = lt, .rb = rb}; }
+	[[nodiscard]] auto get_uv() const -> kvf::UvRect {
+		auto const uv_rect = glm::vec4(uv) / 65535.0f;
+		return kvf::UvRect{.lt = {uv_rect.x, uv_rect.y}, .rb = {uv_rect.z, uv_rect.w}};
+	}
+
+	/// \returns Vertices of the quad, laid out for shape::Quad::indices_v.
+	[[nodiscard]] auto to_vertices() const -> std::array<Vertex, vertex_count_v> {
+		auto const rect = get_rect();
+		auto const uv_rect = get_uv();
+		auto const vec4_color = glm::vec4(color) / 255.0f;
+		return std::array{
+			Vertex{.position = rect.bottom_left(), .color = vec4_color, .uv = uv_rect.bottom_left()},
+			Vertex{.position = rect.bottom_right(), .color = vec4_color, .uv = uv_rect.bottom_right()},
+			Vertex{.position = rect.top_right(), .color = vec4_color, .uv = uv_rect.top_right()},
+			Vertex{.position = rect.top_left(), .color = vec4_color, .uv = uv_rect.top_left()},
+		};
+	}
+};
+
+static_assert(sizeof(GlyphInstance) == 32);
+} // namespace le
@@ -0,0 +1,57 @@
+#pragma once
+#include "klib/task/queue_create_info.hpp"
+#include "le2d/render_instance.hpp"
+#include <memory>
+#include <span>
+
+namespace le {
+/// \brief Structure-of-arrays RenderInstance data for bulk baking.
+/// Non-empty spans must have the same size as positions.
+struct RenderInstanceStreams {
+	[[nodiscard]] auto get_size() const -> std::size_t { return positions.size(); }
+
+	std::span<glm::vec2 const> positions{};
+	/// \brief Normalized orientations, right_v if empty.
+	std::span<glm::vec2 const> orientations{};
+	/// \brief Scales, 1 if empty.
+	std::span<glm::vec2 const> scales{};
+	/// \brief Tints (in sRGB space), white if empty.
+	std::span<kvf::Color const> tints{};
+};
+
+/// \brief Bake RenderInstances on the calling thread.
+/// Equivalent to RenderInstance::to_std430() per instance, without trigonometry or pow() calls.
+/// \param out Destination, must be at least as large as in.
+/// \param in Instances to bake.
+/// \param linearize_tint Whether to convert tints to linear space.
+void bake_instances(std::span<RenderInstance::Std430> out, std::span<RenderInstance const> in, bool linearize_tint = true);
+/// \brief Bake RenderInstanceStreams on the calling thread.
+/// \param out Destination, must be at least as large as in.get_size().
+/// \param in Instance streams to bake.
+/// \param linearize_tint Whether to convert tints to linear space.
+void bake_instances(std::span<RenderInstance::Std430> out, RenderInstanceStreams const& in, bool linearize_tint = true);
+/// \brief Expand compact RenderInstances on the calling thread.
+/// \param out Destination, must be at least as large as in.
+/// \param in Compact instances to expand.
+void bake_instances(std::span<RenderInstance::Std430> out, std::span<RenderInstance::Compact const> in);
+
+struct InstanceBakerCreateInfo {
+	/// \brief Number of worker threads for internal task queue.
+	klib::task::ThreadCount thread_count{klib::task::get_max_threads()};
+	/// \brief Inputs smaller than this are baked on the calling thread.
+	std::size_t min_parallel_count{16384};
+};
+
+/// \brief Bakes large instance spans in parallel across worker threads.
+class IInstanceBaker : public klib::Polymorphic {
+  public:
+	using CreateInfo = InstanceBakerCreateInfo;
+
+	[[nodiscard]] static auto create(CreateInfo const& create_info = {}) -> std::unique_ptr<IInstanceBaker>;
+
+	/// \brief Bake instances, blocks until complete.
+	virtual void bake(std::span<RenderInstance::Std430> out, std::span<RenderInstance const> in, bool linearize_tint = true) = 0;
+	/// \brief Bake instance streams, blocks until complete.
+	virtual void bake(std::span<RenderInstance::Std430> out, RenderInstanceStreams const& in, bool linearize_tint = true) = 0;
+};
+} // namespace le
@@ -1,17 +1,30 @@
 #pragma once
 #include "klib/ptr.hpp"
+#include "le2d/glyph_instance.hpp"
 #include "le2d/resource/texture.hpp"
 #include "le2d/vertex.hpp"
 #include <cstdint>
 #include <span>
 
 namespace le {
+class IGeometryBuffer;
+
 /// \brief Draw primitive.
 /// Intended to be transient: created, used, and discarded per frame.
 struct Primitive {
 	std::span<Vertex const> vertices{};
+	/// \brief Packed vertices to upload instead of vertices, if not empty (vertices is then ignored).
+	std::span<PackedVertex const> packed_vertices{};
 	std::span<std::uint32_t const> indices{};
+	/// \brief Glyph quads to draw instead of vertices and indices, if not empty (topology is then ignored).
+	/// Built-in shaders expand each glyph on the GPU, other shaders receive its 4 vertices over shape::Quad::list_indices().
+	std::span<GlyphInstance const> glyphs{};
 	vk::PrimitiveTopology topology{vk::PrimitiveTopology::eTriangleList};
 	klib::Ptr<ITextureBase const> texture{};
+	/// \brief Retained geometry to draw instead of uploading vertices / indices.
+	klib::Ptr<IGeometryBuffer const> geometry_buffer{};
+
+	[[nodiscard]] auto get_vertex_format() const -> VertexFormat { return packed_vertices.empty() ? VertexFormat::Standard : VertexFormat::Packed; }
+	[[nodiscard]] auto get_vertex_count() const -> std::size_t { return packed_vertices.empty() ? vertices.size() : packed_vertices.size(); }
 };
 } // namespace le
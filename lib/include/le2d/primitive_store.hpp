@@ -0,0 +1,53 @@
+#pragma once
+#include "le2d/renderer.hpp"
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace le {
+/// \brief Owned copies of Primitives and their baked instances, for deferred draws (see DrawQueue and DrawRecorder).
+class PrimitiveStore {
+  public:
+	struct Range {
+		std::uint32_t offset{};
+		std::uint32_t count{};
+	};
+
+	/// \brief A stored draw, as ranges into the store.
+	struct Entry {
+		Range vertices{};
+		Range indices{};
+		Range glyphs{};
+		Range instances{};
+		vk::PrimitiveTopology topology{};
+		ITextureBase const* texture{};
+		IGeometryBuffer const* geometry_buffer{};
+		// indices view shape::Quad::list_indices() and are not copied.
+		bool quad_list{};
+		// vertices index m_packed_vertices instead of m_vertices.
+		bool packed{};
+	};
+
+	/// \brief Copy a Primitive and bake its instances.
+	/// \returns Stored draw, or nullopt if there is nothing to draw.
+	[[nodiscard]] auto push(Primitive const& primitive, std::span<RenderInstance const> instances) -> std::optional<Entry>;
+	/// \brief Copy a Primitive and its pre-baked instances.
+	/// \returns Stored draw, or nullopt if there is nothing to draw.
+	[[nodiscard]] auto push_baked(Primitive const& primitive, std::span<RenderInstance::Std430 const> instances) -> std::optional<Entry>;
+
+	/// \brief Draw a stored entry through renderer.
+	void draw(IRenderer& renderer, Entry const& entry) const;
+	/// \brief Discard all stored data, retaining storage.
+	void clear();
+
+  private:
+	[[nodiscard]] auto store(Primitive const& primitive, Range instances) -> Entry;
+
+	std::vector<Vertex> m_vertices{};
+	std::vector<PackedVertex> m_packed_vertices{};
+	std::vector<std::uint32_t> m_indices{};
+	std::vector<GlyphInstance> m_glyphs{};
+	std::vector<RenderInstance::Std430> m_instances{};
+};
+} // namespace le
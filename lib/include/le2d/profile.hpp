@@ -0,0 +1,49 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace le::profile {
+using Clock = std::chrono::steady_clock;
+
+/// \brief Number of zones retained per thread, older zones are overwritten.
+inline constexpr std::size_t ring_capacity_v{8192};
+
+/// \brief Enable / disable zone capture (disabled by default).
+void set_enabled(bool enabled);
+[[nodiscard]] auto is_enabled() -> bool;
+
+/// \brief RAII guard that records a named timing zone on the calling thread.
+/// Zones nest by time: a zone opened within another becomes its child in the trace.
+class Zone {
+  public:
+	Zone(Zone const&) = delete;
+	Zone(Zone&&) = delete;
+	Zone& operator=(Zone const&) = delete;
+	Zone& operator=(Zone&&) = delete;
+
+	/// \param name Zone name, must have static storage duration.
+	explicit Zone(char const* name);
+	~Zone();
+
+  private:
+	char const* m_name;
+	Clock::time_point m_start{};
+};
+
+/// \brief Serialize zones captured on all threads as Chrome trace-event JSON.
+/// \returns JSON string (open in chrome://tracing or Perfetto).
+[[nodiscard]] auto to_chrome_trace() -> std::string;
+/// \brief Discard zones captured on all threads.
+void clear();
+} // namespace le::profile
+
+#define LE_PROFILE_CONCAT_IMPL(a, b) a##b
+#define LE_PROFILE_CONCAT(a, b) LE_PROFILE_CONCAT_IMPL(a, b)
+
+#if defined(LE_PROFILE_DISABLE)
+#define LE_PROFILE_ZONE(name)
+#else
+/// \brief Record a profile::Zone for the remainder of the enclosing scope.
+#define LE_PROFILE_ZONE(name) ::le::profile::Zone const LE_PROFILE_CONCAT(le_profile_zone_, __LINE__)(name)
+#endif
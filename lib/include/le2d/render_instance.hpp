@@ -1,6 +1,7 @@
 #pragma once
 #include "kvf/color.hpp"
 #include "le2d/transform.hpp"
+#include <cstdint>
 
 namespace le {
 /// \brief Instance data for instanced rendering.
@@ -10,6 +11,24 @@ struct RenderInstance {
 		glm::vec4 tint;
 	};
 
+	/// \brief Compact 2D instance data: 2x2 linear transform, translation, and sRGB tint.
+	/// Uploaded as-is for the default shader and shaders created with InstanceFormat::Compact (see lib/glsl/compact.vert), else expanded to Std430.
+	struct Compact {
+		/// \brief Columns of the 2x2 linear transform: (col0.x, col0.y, col1.x, col1.y).
+		glm::vec4 linear{1.0f, 0.0f, 0.0f, 1.0f};
+		glm::vec2 translation{};
+		kvf::Color tint{kvf::white_v};
+		std::uint32_t padding{};
+
+		[[nodiscard]] auto to_std430() const -> Std430 {
+			auto transform = glm::mat4{1.0f};
+			transform[0] = glm::vec4{linear.x, linear.y, 0.0f, 0.0f};
+			transform[1] = glm::vec4{linear.z, linear.w, 0.0f, 0.0f};
+			transform[3] = glm::vec4{translation, 0.0f, 1.0f};
+			return Std430{.transform = transform, .tint = tint.to_linear()};
+		}
+	};
+
 	[[nodiscard]] auto to_std430(bool const linearize_tint = true) const -> Std430 {
 		return Std430{
 			.transform = transform.to_model(),
@@ -17,7 +36,19 @@ struct RenderInstance {
 		};
 	}
 
+	[[nodiscard]] auto to_compact() const -> Compact {
+		auto const& o = transform.orientation;
+		auto const& s = transform.scale;
+		return Compact{
+			.linear = {s.x * o.x, s.x * o.y, -s.y * o.y, s.y * o.x},
+			.translation = transform.position,
+			.tint = tint,
+		};
+	}
+
 	Transform transform{};
 	kvf::Color tint{kvf::white_v};
 };
+
+static_assert(sizeof(RenderInstance::Compact) == 32);
 } // namespace le
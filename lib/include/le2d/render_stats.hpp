@@ -1,14 +1,59 @@
 #pragma once
+#include <algorithm>
+#include <chrono>
 #include <cstdint>
 
 namespace le {
 struct RenderStats {
+	/// \brief Draw commands recorded.
 	std::int64_t draw_calls{};
 	std::int64_t triangles{};
+	/// \brief Draws requested via IRenderer.
+	std::int64_t submitted_draws{};
+	/// \brief Instances requested via IRenderer (after culling).
+	std::int64_t instances{};
+	/// \brief Requested draws merged into a preceding batch (did not need their own upload).
+	std::int64_t merged_draws{};
+	/// \brief Descriptor sets allocated.
+	std::int64_t descriptor_sets{};
+	/// \brief Descriptors written.
+	std::int64_t descriptor_writes{};
+	/// \brief Pipeline state / binding commands recorded.
+	std::int64_t state_changes{};
+	/// \brief Pipeline state / binding commands skipped as redundant.
+	std::int64_t state_changes_skipped{};
+	/// \brief Shader objects bound (subset of state_changes).
+	std::int64_t shader_binds{};
+	/// \brief Bytes written to scratch (vertex / index / instance / view) buffers.
+	std::int64_t bytes_uploaded{};
+	/// \brief Scratch bytes uploaded by the largest pass (high-water mark), maximum when accumulated.
+	std::int64_t peak_scratch_bytes{};
+	/// \brief Draws dropped because a pass' instance stream would exceed the device's storage buffer range.
+	std::int64_t scratch_overflows{};
+	/// \brief Scratch buffers grown (and their contents copied) mid-pass, until each reaches its high-water mark.
+	std::int64_t scratch_grows{};
+	/// \brief CPU time spent writing draws (IRenderer draw calls) and recording them into the command buffer.
+	std::chrono::nanoseconds draw_time{};
+	/// \brief Instances dropped by IRenderer::draw_culled().
+	std::int64_t culled_instances{};
 
 	constexpr void accumulate(RenderStats const& other) {
 		draw_calls += other.draw_calls;
 		triangles += other.triangles;
+		submitted_draws += other.submitted_draws;
+		instances += other.instances;
+		merged_draws += other.merged_draws;
+		descriptor_sets += other.descriptor_sets;
+		descriptor_writes += other.descriptor_writes;
+		state_changes += other.state_changes;
+		state_changes_skipped += other.state_changes_skipped;
+		shader_binds += other.shader_binds;
+		bytes_uploaded += other.bytes_uploaded;
+		peak_scratch_bytes = std::max(peak_scratch_bytes, other.peak_scratch_bytes);
+		scratch_overflows += other.scratch_overflows;
+		scratch_grows += other.scratch_grows;
+		draw_time += other.draw_time;
+		culled_instances += other.culled_instances;
 	}
 
 	[[nodiscard]] constexpr auto accumulated(RenderStats const& other) const -> RenderStats {
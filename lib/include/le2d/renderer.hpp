@@ -2,6 +2,7 @@
 #include "klib/base_types.hpp"
 #include "kvf/rect.hpp"
 #include "kvf/render_target.hpp"
+#include "le2d/frame_stats.hpp"
 #include "le2d/primitive.hpp"
 #include "le2d/render_instance.hpp"
 #include "le2d/render_stats.hpp"
@@ -11,6 +12,8 @@
 #include "le2d/viewport.hpp"
 
 namespace le {
+class DrawRecorder;
+
 class IRenderer : public klib::Polymorphic {
   public:
 	static constexpr auto min_size_v{32};
@@ -18,6 +21,9 @@ class IRenderer : public klib::Polymorphic {
 
 	using UserData = UserDrawData;
 
+	/// \brief Obtain the render command buffer to record commands directly.
+	/// Draws are deferred until the end of the pass: call flush() first for commands that must follow earlier draws.
+	/// \returns Render command buffer, null if not rendering.
 	[[nodiscard]] virtual auto command_buffer() const -> vk::CommandBuffer = 0;
 	[[nodiscard]] virtual auto get_stats() const -> RenderStats const& = 0;
 
@@ -32,6 +38,9 @@ class IRenderer : public klib::Polymorphic {
 	virtual auto begin_render(vk::CommandBuffer command_buffer, glm::ivec2 size, kvf::Color clear = kvf::black_v) -> bool = 0;
 	/// \brief End rendering.
 	virtual auto end_render() -> kvf::RenderTarget const& = 0;
+	/// \brief Record all pending draws (including those of forked recorders) into the command buffer.
+	/// State bound by commands recorded afterwards is not restored, subsequent draws rebind what they need.
+	virtual void flush() = 0;
 
 	[[nodiscard]] virtual auto framebuffer_size() const -> glm::ivec2 = 0;
 
@@ -42,10 +51,13 @@ class IRenderer : public klib::Polymorphic {
 	virtual void set_viewport(Viewport const& viewport) = 0;
 
 	virtual void set_line_width(float width) = 0;
+	[[nodiscard]] virtual auto get_shader() const -> IShader const& = 0;
 	virtual void set_shader(IShader const& shader) = 0;
 	virtual void set_user_data(UserDrawData const& user_data) = 0;
 
 	/// \brief Draw given instances of a Primitive.
+	/// With batch_draws and a built-in shader, a lone instance is applied to the vertices on the CPU,
+	/// and the shader receives an identity instance instead. Custom shaders always receive the given instances.
 	/// \param primitive Primitive to draw.
 	/// \param instances Render Instances to draw (will be baked).
 	virtual void draw(Primitive const& primitive, std::span<RenderInstance const> instances) = 0;
@@ -53,6 +65,37 @@ class IRenderer : public klib::Polymorphic {
 	/// \param primitive Primitive to draw.
 	/// \param instances Render Instances to draw (pre-baked).
 	virtual void draw_baked(Primitive const& primitive, std::span<RenderInstance::Std430 const> instances) = 0;
+	/// \brief Draw given instances of a Primitive.
+	/// Uploaded as-is for the default shader (drawn with its built-in compact variant) and shaders using InstanceFormat::Compact,
+	/// expanded to Std430 for other shaders.
+	/// \param primitive Primitive to draw.
+	/// \param instances Render Instances to draw (compact).
+	virtual void draw_compact(Primitive const& primitive, std::span<RenderInstance::Compact const> instances) = 0;
+
+	/// \brief Obtain a cleared DrawRecorder whose draws are inserted at this point in the pass.
+	/// Its draws start with the renderer state at the time of this call, and are ordered between the draws before and after it.
+	/// Call on the render thread, the returned recorder can then be filled on any thread.
+	/// Only building the draw list (copying and baking) is parallel: Vulkan commands are recorded on the render thread when it is replayed.
+	/// All forked recorders must be complete before flush() or end_render() is called (they are replayed there).
+	/// \returns Recorder owned by the renderer, valid until the next begin_render().
+	[[nodiscard]] virtual auto fork() -> DrawRecorder& = 0;
+
+	/// \returns World space rect visible through the current view and viewport.
+	[[nodiscard]] virtual auto get_view_rect() const -> kvf::Rect<> = 0;
+	/// \brief Draw instances of a Primitive whose bounds intersect get_view_rect().
+	/// \param primitive Primitive to draw.
+	/// \param instances Render Instances to cull and draw (survivors will be baked).
+	/// \param local_bounds Bounds of primitive in model space (eg via IGeometry::get_local_bounds()).
+	virtual void draw_culled(Primitive const& primitive, std::span<RenderInstance const> instances, kvf::Rect<> const& local_bounds) = 0;
+
+	/// \brief Begin a labelled draw group, timed on the GPU if gpu_timestamps is set.
+	/// Groups can be nested, and must be ended before end_render() (open groups are closed there).
+	/// \param label Group label.
+	virtual void begin_gpu_zone(std::string_view label) = 0;
+	/// \brief End the innermost draw group.
+	virtual void end_gpu_zone() = 0;
+	/// \returns GPU timings of a previous pass (a few passes late), in begin order. Empty if unsupported / disabled.
+	[[nodiscard]] virtual auto get_gpu_timings() const -> std::span<GpuTiming const> = 0;
 
 	/// \returns Unprojector for current view and viewport.
 	[[nodiscard]] virtual auto unprojector() const -> Unprojector = 0;
@@ -64,5 +107,18 @@ class IRenderer : public klib::Polymorphic {
 	vk::PolygonMode polygon_mode{vk::PolygonMode::eFill};
 	/// \brief Scissor rect.
 	kvf::UvRect scissor_rect{kvf::uv_rect_v};
+	/// \brief Defer draws and merge compatible ones into shared vertex / index / instance streams.
+	/// Pending draws are flushed on state changes (shader, view, viewport, etc) and in end_render().
+	/// Texture changes do not flush: they only rebind the texture between draw calls of a batch (see merge_textures).
+	/// Lone instances are baked into vertices only with built-in shaders (see draw()).
+	/// UserDrawData::ssbo must remain valid until the next flush.
+	bool batch_draws{false};
+	/// \brief With batch_draws and the default shader, index color textures of a batch through a texture table (a descriptor-indexed array).
+	/// Lone instances of different textures then share a draw call instead of each texture starting a new one.
+	/// Requires a device created with non-uniform indexing of sampler arrays (shaderSampledImageArrayNonUniformIndexing) enabled, ignored otherwise.
+	/// The render device does not enable it yet: batches currently still rebind textures per run.
+	bool merge_textures{false};
+	/// \brief Record timestamp queries around each pass and GPU zone (applied in begin_render()).
+	bool gpu_timestamps{false};
 };
 } // namespace le
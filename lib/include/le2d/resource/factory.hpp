@@ -2,6 +2,7 @@
 #include "kvf/kvf_fwd.hpp"
 #include "le2d/resource/audio_buffer.hpp"
 #include "le2d/resource/font.hpp"
+#include "le2d/resource/geometry_buffer.hpp"
 #include "le2d/resource/shader.hpp"
 #include "le2d/resource/texture.hpp"
 #include <memory>
@@ -16,8 +17,10 @@ class IResourceFactory : public klib::Polymorphic {
 
 	/// \param vertex Vertex shader SPIR-V code.
 	/// \param fragment Fragment shader SPIR-V code.
+	/// \param instance_format Layout of instance data read by vertex shader.
 	/// \returns Concrete instance if successfully loaded.
-	[[nodiscard]] virtual auto create_shader(SpirV vertex, SpirV fragment) const -> std::unique_ptr<IShader> = 0;
+	[[nodiscard]] virtual auto create_shader(SpirV vertex, SpirV fragment, InstanceFormat instance_format = InstanceFormat::Std430) const
+		-> std::unique_ptr<IShader> = 0;
 
 	/// \param bitmap Bitmap to write.
 	/// \param sampler TextureSampler to use.
@@ -37,6 +40,17 @@ class IResourceFactory : public klib::Polymorphic {
 	/// \returns Concrete instance if successfully loaded.
 	[[nodiscard]] virtual auto create_font(std::vector<std::byte> font_bytes) const -> std::unique_ptr<IFont> = 0;
 
+	/// \param size Size of page in pixels.
+	/// \returns Concrete instance.
+	[[nodiscard]] virtual auto create_font_page(glm::ivec2 size = IFontPage::default_size_v) const -> std::unique_ptr<IFontPage> = 0;
+
+	/// \brief Create a retained geometry buffer.
+	/// \param vertices Vertices to write.
+	/// \param indices Indices to write (can be empty).
+	/// \returns Concrete instance if successfully allocated.
+	[[nodiscard]] virtual auto create_geometry_buffer(std::span<Vertex const> vertices, std::span<std::uint32_t const> indices = {}) const
+		-> std::unique_ptr<IGeometryBuffer> = 0;
+
 	/// \param bytes Compressed audio bytes to decode.
 	/// \param encoding Encoding of audio data, if known.
 	/// \returns Concrete instance if successfully decoded.
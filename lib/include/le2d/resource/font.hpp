@@ -1,31 +1,113 @@
 #pragma once
+#include "klib/ptr.hpp"
 #include "kvf/ttf.hpp"
 #include "le2d/resource/texture.hpp"
 #include "le2d/text_height.hpp"
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
 
 namespace le {
+class FileDataLoader;
+
 /// \brief Opaque interface for a Font Atlas.
 class IFontAtlas : public IResource {
   public:
 	using Glyph = kvf::ttf::Glyph;
 	using GlyphLayout = kvf::ttf::GlyphLayout;
 
-	[[nodiscard]] virtual auto get_glyphs() const -> std::span<Glyph const> = 0;
+	/// \brief Get the glyph for a codepoint.
+	/// \returns Glyph, or nullptr if the atlas has none for codepoint. Remains valid for the lifetime of the atlas.
+	[[nodiscard]] virtual auto get_glyph(char32_t codepoint) const -> Glyph const* = 0;
 	[[nodiscard]] virtual auto get_texture() const -> ITexture const& = 0;
 	[[nodiscard]] virtual auto get_height() const -> TextHeight = 0;
+	/// \brief Identifies the face and page the glyphs were built from, unique across fonts.
+	/// Changes when the owning font's face or page changes, compare it (with the height) to detect stale layouts.
+	[[nodiscard]] virtual auto get_generation() const -> std::uint64_t = 0;
 
+	/// \brief Lay out glyphs for text.
+	/// Glyphs in layouts remain valid for the lifetime of the atlas, even if its font's face or page is changed.
+	/// \returns Position of the next glyph's baseline.
 	virtual auto push_layouts(std::vector<GlyphLayout>& out, std::string_view text, float n_line_height = 1.5f, bool use_tofu = true) const -> glm::vec2 = 0;
 };
 
+/// \brief Opaque interface for a texture page shared by Font Atlases of multiple fonts and heights.
+/// Atlases are shelf-packed into a fixed size page, text using any of them can then be batched together.
+/// Safe to use from multiple threads: fonts pack into it concurrently.
+class IFontPage : public IResource {
+  public:
+	static constexpr auto default_size_v = glm::ivec2{2048};
+
+	[[nodiscard]] virtual auto get_texture() const -> ITexture const& = 0;
+	/// \returns Fraction of the page's height that has been allocated.
+	[[nodiscard]] virtual auto get_occupancy() const -> float = 0;
+
+	/// \brief Copy a bitmap into a free region of the page.
+	/// Released regions are reused (best fit) before new shelves are opened. The page is uploaded by the next get_texture().
+	/// \param bitmap Single channel bitmap to copy (one byte of coverage per texel), stored as the alpha of white texels.
+	/// \returns UV rect of the packed region, nullopt if the page is full.
+	[[nodiscard]] virtual auto pack(kvf::Bitmap const& bitmap) -> std::optional<kvf::UvRect> = 0;
+	/// \brief Release a region returned by pack(), so that it can be reused.
+	/// The page is emptied when its last region is released.
+	/// \param region UV rect returned by pack().
+	virtual void release(kvf::UvRect const& region) = 0;
+};
+
+/// \brief Font Atlas and the scale to apply to its glyphs.
+struct ScaledAtlas {
+	klib::Ptr<IFontAtlas> atlas{};
+	float scale{1.0f};
+};
+
 /// \brief Opaque interface for a Font.
 class IFont : public IResource {
   public:
+	/// \brief Text height the distance field atlas is rasterized at.
+	static constexpr auto distance_field_height_v = TextHeight{48};
+	/// \brief Distance in texels (at distance_field_height_v) covered by the distance field on either side of glyph edges.
+	static constexpr std::int32_t distance_field_spread_v{6};
+
+	/// \brief Load a face, existing atlases are rebuilt from it in place (references to them stay valid).
 	/// \param font_bytes Copy of TTF / OTF data as bytes.
 	/// \returns true if successfully loaded.
 	virtual auto load_face(std::vector<std::byte> font_bytes) -> bool = 0;
 
 	[[nodiscard]] virtual auto get_name() const -> klib::CString = 0;
 
+	/// \brief Set a persistent cache for built atlases, keyed by a hash of the font bytes and the text height.
+	/// Atlases found in the cache are uploaded directly, others are rasterized and then saved to it.
+	/// \param loader Loader to read / write cache files through (nullptr to disable caching).
+	/// \param directory URI of directory for cache files.
+	virtual void set_atlas_cache(klib::Ptr<FileDataLoader const> loader, std::string directory = "font_atlases") = 0;
+
+	/// \brief Pack atlases into a shared page instead of a texture per atlas.
+	/// Existing atlases are rebuilt in place (references to them stay valid) and their generation changes.
+	/// Atlases that don't fit in the page fall back to their own texture.
+	/// Regions of this font's atlases are released when they are rebuilt, and when the font is destroyed.
+	/// \param page Page to pack into (must outlive this font), nullptr to use a texture per atlas.
+	virtual void set_page(klib::Ptr<IFontPage> page) = 0;
+
+	/// \brief Get the atlas for a text height, building it on first use.
+	/// Blocks if the atlas is being prewarmed and not yet ready.
 	[[nodiscard]] virtual auto get_atlas(TextHeight height) -> IFontAtlas& = 0;
+	/// \brief Get the signed distance field atlas, building it on first use.
+	/// Built from the glyphs of the atlas at distance_field_height_v, and drawn with sharp edges at any scale by built-in shaders.
+	/// Not packed into the shared page.
+	[[nodiscard]] virtual auto get_distance_field_atlas() -> IFontAtlas& = 0;
+	/// \brief Get the distance field atlas and the scale to draw it at any text height.
+	/// A single atlas serves every height, so memory stays constant however many heights are used.
+	/// \param height Desired text height in pixels.
+	/// \returns Distance field atlas, and the scale to reach height.
+	[[nodiscard]] virtual auto get_scaled_atlas(float height) -> ScaledAtlas = 0;
+
+	/// \brief Rasterize atlases for heights on a worker thread.
+	/// Prewarmed atlases are uploaded by the next get_atlas() call for their height, without rasterizing.
+	/// \param heights Text heights to prewarm (already built / pending ones are ignored).
+	virtual void prewarm(std::span<TextHeight const> heights) = 0;
+	/// \brief Check whether get_atlas(height) would not need to wait or rasterize. Safe to call from any thread.
+	/// \param height Text height to query.
+	/// \returns true if the atlas is built or its prewarm has completed.
+	[[nodiscard]] virtual auto is_ready(TextHeight height) const -> bool = 0;
 };
 } // namespace le
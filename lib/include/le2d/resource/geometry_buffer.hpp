@@ -0,0 +1,48 @@
+#pragma once
+#include "le2d/geometry.hpp"
+#include "le2d/resource/resource.hpp"
+#include "le2d/shape/quad.hpp"
+#include "le2d/vertex_array.hpp"
+#include <vulkan/vulkan.hpp>
+
+namespace le {
+/// \brief Retained GPU vertex / index storage for static geometry.
+/// Contents persist across frames, so drawing from it uploads nothing.
+/// Each write allocates new storage (the previous one is released once frames in flight have completed), intended for load-time / infrequent use.
+class IGeometryBuffer : public IResource {
+  public:
+	/// \brief Write vertices and indices, resizing storage if necessary.
+	/// \param vertices Vertices to write.
+	/// \param indices Indices to write (can be empty).
+	/// \returns false if allocation failed.
+	virtual auto write(std::span<Vertex const> vertices, std::span<std::uint32_t const> indices) -> bool = 0;
+
+	[[nodiscard]] virtual auto get_buffer() const -> vk::Buffer = 0;
+	[[nodiscard]] virtual auto get_vertex_count() const -> std::uint32_t = 0;
+	[[nodiscard]] virtual auto get_index_count() const -> std::uint32_t = 0;
+	/// \returns Byte offset of indices within buffer.
+	[[nodiscard]] virtual auto get_index_offset() const -> vk::DeviceSize = 0;
+
+	/// \brief Write vertices and indices of geometry.
+	/// Retained geometry is always in the standard format: packed vertices are unpacked, glyphs are expanded into indexed quads.
+	auto write(IGeometry const& geometry) -> bool {
+		if (auto const glyphs = geometry.get_glyphs(); !glyphs.empty()) {
+			auto vertices = std::vector<Vertex>{};
+			unpack_glyphs(vertices, glyphs);
+			auto indices = std::vector<std::uint32_t>{};
+			indices.reserve(glyphs.size() * shape::Quad::indices_v.size());
+			for (auto base = std::uint32_t{}; base < std::uint32_t(vertices.size()); base += std::uint32_t(GlyphInstance::vertex_count_v)) {
+				for (auto const i : shape::Quad::indices_v) { indices.push_back(base + i); }
+			}
+			return write(vertices, indices);
+		}
+		auto const packed = geometry.get_packed_vertices();
+		if (packed.empty()) { return write(geometry.get_vertices(), geometry.get_indices()); }
+		auto vertices = std::vector<Vertex>{};
+		unpack_vertices(vertices, packed);
+		return write(vertices, geometry.get_indices());
+	}
+
+	[[nodiscard]] auto is_loaded() const -> bool { return get_vertex_count() > 0; }
+};
+} // namespace le
@@ -1,8 +1,21 @@
 #pragma once
 #include "kvf/graphics_shader.hpp"
 #include "le2d/resource/resource.hpp"
+#include "le2d/vertex.hpp"
+#include <cstdint>
 
 namespace le {
+/// \brief Layout of per-instance data a vertex shader reads from set 1, binding 0.
+enum class InstanceFormat : std::int8_t {
+	/// \brief RenderInstance::Std430.
+	Std430,
+	/// \brief RenderInstance::Compact.
+	Compact,
+	/// \brief GlyphInstance, drawn as a 4 vertex triangle strip each (see lib/glsl/glyph.vert).
+	/// The draw's RenderInstances are read from set 1, binding 2 (as RenderInstance::Std430).
+	Glyph,
+};
+
 /// \brief Opaque interface for a Shader program.
 class IShader : public IResource {
   public:
@@ -10,6 +23,10 @@ class IShader : public IResource {
 
 	[[nodiscard]] virtual auto load(SpirV vertex, SpirV fragment) -> bool = 0;
 
-	[[nodiscard]] virtual auto get_kvf_shader() const -> kvf::IGraphicsShader const& = 0;
+	/// \brief Get the shader object whose vertex input matches format.
+	[[nodiscard]] virtual auto get_kvf_shader(VertexFormat format) const -> kvf::IGraphicsShader const& = 0;
+	/// \brief Get the shader object for VertexFormat::Standard.
+	[[nodiscard]] auto get_kvf_shader() const -> kvf::IGraphicsShader const& { return get_kvf_shader(VertexFormat::Standard); }
+	[[nodiscard]] virtual auto get_instance_format() const -> InstanceFormat = 0;
 };
 } // namespace le
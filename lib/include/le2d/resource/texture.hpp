@@ -17,6 +17,10 @@ class ITextureBase : public IResource {
 	virtual void set_sampler(TextureSampler const& sampler) = 0;
 
 	[[nodiscard]] virtual auto descriptor_info() const -> vk::DescriptorImageInfo = 0;
+
+	/// \brief Whether the image holds a signed distance field in alpha (edges at 0.5), eg a distance field font atlas.
+	/// Built-in shaders reconstruct sharp edges from such textures at any scale.
+	[[nodiscard]] virtual auto is_distance_field() const -> bool { return false; }
 };
 
 /// \brief Concrete drawable Texture.
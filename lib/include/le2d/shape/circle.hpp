@@ -6,6 +6,9 @@ namespace le::shape {
 struct CircleParams {
 	kvf::Color color{kvf::white_v};
 	std::int32_t resolution{128};
+	/// \brief Packed stores (and uploads) PackedVertex instead of Vertex, get_vertices() is then empty.
+	/// Falls back to Standard if any UV is outside [0, 1].
+	VertexFormat vertex_format{VertexFormat::Standard};
 };
 
 /// \brief Circle Geometry.
@@ -20,6 +23,8 @@ class Circle : public IGeometry {
 	[[nodiscard]] auto get_vertices() const -> std::span<Vertex const> final { return m_sector.get_vertices(); }
 	[[nodiscard]] auto get_indices() const -> std::span<std::uint32_t const> final { return m_sector.get_indices(); }
 	[[nodiscard]] auto get_topology() const -> vk::PrimitiveTopology final { return m_sector.get_topology(); }
+	[[nodiscard]] auto get_packed_vertices() const -> std::span<PackedVertex const> final { return m_sector.get_packed_vertices(); }
+	[[nodiscard]] auto get_local_bounds() const -> kvf::Rect<> final { return m_sector.get_local_bounds(); }
 
 	void create(float diameter = default_diameter_v, Params const& params = {});
 
@@ -2,6 +2,8 @@
 #include "kvf/color.hpp"
 #include "kvf/rect.hpp"
 #include "le2d/geometry.hpp"
+#include <array>
+#include <variant>
 
 namespace le::shape {
 /// \brief Interface for Quad Geometry.
@@ -13,7 +15,16 @@ class IQuad : public IGeometry {
 
 	explicit(false) IQuad(glm::vec2 const size = default_size_v) { create(size); }
 
-	[[nodiscard]] auto get_vertices() const -> std::span<Vertex const> final { return m_vertices; }
+	[[nodiscard]] auto get_vertices() const -> std::span<Vertex const> final;
+	[[nodiscard]] auto get_packed_vertices() const -> std::span<PackedVertex const> final;
+	[[nodiscard]] auto get_local_bounds() const -> kvf::Rect<> final { return get_rect(); }
+
+	/// \returns Format the vertices are stored in.
+	[[nodiscard]] auto get_vertex_format() const -> VertexFormat;
+	/// \brief Store (and upload) PackedVertex instead of Vertex, from now on.
+	/// Falls back to Standard while UVs are outside [0, 1] (eg tiling).
+	/// \param format Requested format.
+	void set_vertex_format(VertexFormat format);
 
 	void create(glm::vec2 size = default_size_v);
 	void create(kvf::Rect<> const& rect, kvf::UvRect const& uv = kvf::uv_rect_v, kvf::Color color = kvf::white_v);
@@ -24,17 +35,33 @@ class IQuad : public IGeometry {
 	[[nodiscard]] auto get_origin() const -> glm::vec2 { return get_rect().center(); }
 
   private:
-	std::array<Vertex, vertex_count_v> m_vertices{};
+	using Vertices = std::array<Vertex, vertex_count_v>;
+	using PackedVertices = std::array<PackedVertex, vertex_count_v>;
+
+	void store(Vertices const& vertices);
+	[[nodiscard]] auto get_vertex(std::size_t index) const -> Vertex;
+
+	// only one format is stored.
+	std::variant<Vertices, PackedVertices> m_vertices{};
+	VertexFormat m_requested_format{VertexFormat::Standard};
 };
 
 /// \brief Quad Geometry.
 class Quad : public IQuad {
   public:
 	static constexpr auto indices_v = std::array{0u, 1u, 2u, 2u, 3u, 0u};
+	/// \brief Maximum number of quads supported by list_indices().
+	static constexpr std::size_t max_list_quads_v{16384};
+
+	/// \brief Get indices for a list of contiguous quads (vertex_count_v vertices each).
+	/// The returned span views storage that is also resident on the GPU: draws using it only upload vertices.
+	/// \param count Number of quads (clamped to max_list_quads_v).
+	/// \returns Indices for count quads.
+	[[nodiscard]] static auto list_indices(std::size_t count) -> std::span<std::uint32_t const>;
 
 	using IQuad::IQuad;
 
-	[[nodiscard]] auto get_indices() const -> std::span<std::uint32_t const> final { return indices_v; }
+	[[nodiscard]] auto get_indices() const -> std::span<std::uint32_t const> final { return list_indices(1); }
 	[[nodiscard]] auto get_topology() const -> vk::PrimitiveTopology final { return vk::PrimitiveTopology::eTriangleList; }
 };
 
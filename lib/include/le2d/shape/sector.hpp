@@ -10,6 +10,9 @@ struct SectorParams {
 	std::int32_t resolution{128};
 	float degrees_begin{0.0f};
 	float degrees_end{360.0f};
+	/// \brief Packed stores (and uploads) PackedVertex instead of Vertex, get_vertices() is then empty.
+	/// Falls back to Standard if any UV is outside [0, 1].
+	VertexFormat vertex_format{VertexFormat::Standard};
 };
 
 /// \brief Sector Geometry.
@@ -24,16 +27,21 @@ class Sector : public IGeometry {
 	[[nodiscard]] auto get_vertices() const -> std::span<Vertex const> final { return m_verts.vertices; }
 	[[nodiscard]] auto get_indices() const -> std::span<std::uint32_t const> final { return m_verts.indices; }
 	[[nodiscard]] auto get_topology() const -> vk::PrimitiveTopology final { return vk::PrimitiveTopology::eTriangleFan; }
+	[[nodiscard]] auto get_packed_vertices() const -> std::span<PackedVertex const> final { return m_packed; }
+	[[nodiscard]] auto get_local_bounds() const -> kvf::Rect<> final { return m_bounds; }
 
 	void create(float diameter = default_diameter_v, Params const& params = {});
 
 	[[nodiscard]] auto get_diameter() const -> float { return m_diameter; }
 	[[nodiscard]] auto get_size() const -> glm::vec2 { return glm::vec2{get_diameter()}; }
 
+	/// \returns Standard vertices and indices (vertices are empty if packed).
 	[[nodiscard]] auto get_vertex_array() const -> VertexArray const& { return m_verts; }
 
   private:
 	VertexArray m_verts{};
+	std::vector<PackedVertex> m_packed{};
+	kvf::Rect<> m_bounds{};
 	float m_diameter{};
 };
 } // namespace le::shape
@@ -9,6 +9,9 @@ struct SuperEllipseParams {
 	kvf::Color color{kvf::white_v};
 	float exponent{4.0f};
 	std::int32_t resolution{128};
+	/// \brief Packed stores (and uploads) PackedVertex instead of Vertex, get_vertices() is then empty.
+	/// Falls back to Standard if any UV is outside [0, 1].
+	VertexFormat vertex_format{VertexFormat::Standard};
 };
 
 /// \brief Super ellipse Geometry.
@@ -23,16 +26,21 @@ class SuperEllipse : public IGeometry {
 	[[nodiscard]] auto get_vertices() const -> std::span<Vertex const> final { return m_verts.vertices; }
 	[[nodiscard]] auto get_indices() const -> std::span<std::uint32_t const> final { return m_verts.indices; }
 	[[nodiscard]] auto get_topology() const -> vk::PrimitiveTopology final { return vk::PrimitiveTopology::eTriangleFan; }
+	[[nodiscard]] auto get_packed_vertices() const -> std::span<PackedVertex const> final { return m_packed; }
+	[[nodiscard]] auto get_local_bounds() const -> kvf::Rect<> final { return m_bounds; }
 
 	void create(glm::vec2 size = default_size_v, Params const& params = {});
 
 	[[nodiscard]] auto get_params() const -> Params const& { return m_params; }
 	[[nodiscard]] auto get_size() const -> glm::vec2 { return m_size; }
 
+	/// \returns Standard vertices and indices (vertices are empty if packed).
 	[[nodiscard]] auto get_vertex_array() const -> VertexArray const& { return m_verts; }
 
   private:
 	VertexArray m_verts{};
+	std::vector<PackedVertex> m_packed{};
+	kvf::Rect<> m_bounds{};
 	glm::vec2 m_size{};
 	Params m_params{};
 };
@@ -43,11 +43,14 @@ class LineInput {
 	template <typename PredT>
 	[[nodiscard]] auto backward_from_if(int cursor, PredT pred) const -> int;
 
+	// re-layout glyphs from the edit point onwards, keeping the layouts and quads before it.
+	void update_from(std::size_t edit);
 	void update_cursor_x();
 
 	gsl::not_null<IFontAtlas*> m_atlas;
 
 	std::vector<kvf::ttf::GlyphLayout> m_glyph_layouts{};
+	std::vector<kvf::ttf::GlyphLayout> m_suffix_layouts{};
 	TextGeometry m_geometry{};
 
 	std::string m_line{};
@@ -55,5 +58,7 @@ class LineInput {
 	int m_cursor{};
 	float m_cursor_x{};
 	float m_next_glyph_x{};
+	// generation of the atlas that m_glyph_layouts were built from, kept layouts are discarded when it changes.
+	std::uint64_t m_generation{};
 };
 } // namespace le
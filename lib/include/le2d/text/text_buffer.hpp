@@ -1,16 +1,28 @@
 #pragma once
+#include "le2d/glyph_instance.hpp"
 #include "le2d/primitive.hpp"
 #include "le2d/render_instance.hpp"
+#include "le2d/renderer.hpp"
 #include "le2d/resource/font.hpp"
-#include "le2d/text/text_geometry.hpp"
+#include "le2d/vertex.hpp"
 #include <deque>
 #include <gsl/pointers>
 #include <span>
+#include <vector>
 
 namespace le {
 /// \brief Wall of text as a single Primitive.
+/// Each line is laid out once when pushed; existing lines are moved down by an offset (see to_instance()) instead of being rewritten.
+///
+/// Glyphs are stored as a GlyphInstance each (see Primitive::glyphs).
+///
+/// Draw via draw(), or draw to_offset_primitive() with to_instance() applied to the instance.
+/// Lines keep the UVs they were pushed with: push them again if the atlas' generation changes (its font's face or page changed).
 class TextBuffer {
   public:
+	/// \brief Number of pushed lines after which glyphs are rebased (to bound the magnitude of their coordinates).
+	static constexpr std::size_t rebase_lines_v{1024};
+
 	explicit TextBuffer(gsl::not_null<IFontAtlas*> atlas, std::size_t limit, float n_line_spacing = 1.5f);
 
 	void push_front(std::string text, kvf::Color color) { push_front({&text, 1}, color); }
@@ -18,24 +30,45 @@ class TextBuffer {
 
 	[[nodiscard]] auto get_size() const -> glm::vec2 { return m_size; }
 
-	[[nodiscard]] auto to_primitive() const -> Primitive;
+	/// \brief Offset of the laid out lines relative to the glyphs of to_offset_primitive().
+	[[nodiscard]] auto get_offset() const -> glm::vec2;
+	/// \brief Apply get_offset() to an instance (in its local space).
+	/// \param instance Instance to draw the buffer with.
+	/// \returns Instance to draw to_offset_primitive() with.
+	[[nodiscard]] auto to_instance(RenderInstance instance = {}) const -> RenderInstance;
+
+	/// \brief Glyphs are offset by -get_offset(): the newest line is not at y = 0 unless drawn with to_instance().
+	/// \returns Primitive to draw with to_instance().
+	[[nodiscard]] auto to_offset_primitive() const -> Primitive;
+
+	/// \brief Draw to_offset_primitive() with to_instance(instance).
+	void draw(IRenderer& renderer, RenderInstance const& instance = {}) const;
 
   private:
 	struct Line {
-		std::string text{};
-		kvf::Color color{};
+		std::size_t glyph_count{};
+		float width{};
 	};
 
-	void refresh();
+	[[nodiscard]] auto get_line_height() const -> float;
+
+	void push_line(std::string_view text, kvf::Color color);
+	void pop_line();
+	void rebase();
 
 	gsl::not_null<IFontAtlas*> m_atlas;
 	std::size_t m_limit;
 	float m_n_line_spacing;
 
+	// newest at the front, its glyphs at the back of m_glyphs.
 	std::deque<Line> m_lines{};
 
 	std::vector<kvf::ttf::GlyphLayout> m_layouts{};
-	TextGeometry m_geometry{};
-	glm::vec4 m_size{};
+	std::vector<GlyphInstance> m_glyphs{};
+	// index of the first glyph of the oldest line.
+	std::size_t m_begin{};
+	// lines pushed since the last rebase.
+	std::size_t m_pushed{};
+	glm::vec2 m_size{};
 };
 } // namespace le
@@ -1,24 +1,34 @@
 #pragma once
 #include "kvf/ttf.hpp"
 #include "le2d/geometry.hpp"
+#include "le2d/glyph_instance.hpp"
 #include "le2d/primitive.hpp"
-#include "le2d/vertex_array.hpp"
+#include <vector>
 
 namespace le {
 /// \brief Drawable geometry for text.
+/// Glyphs are stored as a GlyphInstance each, expanded into quads by the built-in shaders (see Primitive::glyphs).
 class TextGeometry : public IGeometry {
   public:
-	[[nodiscard]] auto get_vertices() const -> std::span<Vertex const> final { return m_vertices.vertices; }
-	[[nodiscard]] auto get_indices() const -> std::span<std::uint32_t const> final { return m_vertices.indices; }
+	[[nodiscard]] auto get_vertices() const -> std::span<Vertex const> final { return {}; }
+	[[nodiscard]] auto get_indices() const -> std::span<std::uint32_t const> final { return {}; }
 	[[nodiscard]] auto get_topology() const -> vk::PrimitiveTopology final { return vk::PrimitiveTopology::eTriangleList; }
+	[[nodiscard]] auto get_glyphs() const -> std::span<GlyphInstance const> final { return m_glyphs; }
+	[[nodiscard]] auto get_local_bounds() const -> kvf::Rect<> final { return m_bounds; }
 
-	void append_glyphs(std::span<kvf::ttf::GlyphLayout const> layouts, glm::vec2 offset = {}, kvf::Color color = kvf::white_v);
-	void clear_vertices() { m_vertices.clear(); }
+	void append_glyphs(std::span<kvf::ttf::GlyphLayout const> layouts, glm::vec2 offset = {}, kvf::Color color = kvf::white_v, float scale = 1.0f);
+	void clear_vertices();
+	/// \brief Keep only the first count glyphs.
+	void truncate_glyphs(std::size_t count);
+
+	[[nodiscard]] auto get_glyph_count() const -> std::size_t { return m_glyphs.size(); }
 
-	[[nodiscard]] auto get_vertex_array() const -> VertexArray const& { return m_vertices; }
 	[[nodiscard]] auto to_primitive(ITexture const& font_atlas) const -> Primitive;
 
   private:
-	VertexArray m_vertices{};
+	void extend_bounds(std::size_t first_glyph);
+
+	std::vector<GlyphInstance> m_glyphs{};
+	kvf::Rect<> m_bounds{};
 };
 } // namespace le
@@ -0,0 +1,69 @@
+#pragma once
+#include "le2d/resource/font.hpp"
+#include <algorithm>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace le {
+/// \brief LRU cache of glyph layouts, keyed by atlas, text, and line height.
+/// Shared across text drawables (via TextParams), so repeated / oscillating strings cost a lookup instead of a re-layout.
+/// Entries are keyed by atlas generation and height (not address): layouts of a reloaded font or changed page are never returned.
+class TextLayoutCache {
+  public:
+	static constexpr std::size_t default_capacity_v{256};
+
+	/// \brief Cached layout of a (multi-line) string.
+	struct Layout {
+		std::vector<kvf::ttf::GlyphLayout> glyphs{};
+		kvf::Rect<> bounds{};
+	};
+
+	/// \brief Cache usage counters.
+	struct Stats {
+		std::uint64_t hits{};
+		std::uint64_t misses{};
+	};
+
+	/// \param capacity Maximum number of layouts retained (at least 1).
+	explicit TextLayoutCache(std::size_t capacity = default_capacity_v) : m_capacity(std::max(capacity, std::size_t{1})) {}
+
+	/// \brief Get the cached layout for text, pushing and caching it on a miss.
+	/// \param atlas Font Atlas to lay out glyphs from.
+	/// \param text Text to lay out.
+	/// \param n_line_height Line height for multi-line text, relative to atlas height.
+	/// \returns Layout (valid until the next call).
+	[[nodiscard]] auto get_layout(IFontAtlas const& atlas, std::string_view text, float n_line_height = 1.5f) -> Layout const&;
+
+	[[nodiscard]] auto get_size() const -> std::size_t { return m_entries.size(); }
+	[[nodiscard]] auto get_capacity() const -> std::size_t { return m_capacity; }
+	/// \brief Set the capacity, evicting least recently used layouts if needed.
+	void set_capacity(std::size_t capacity);
+
+	[[nodiscard]] auto get_stats() const -> Stats const& { return m_stats; }
+
+	void clear();
+
+  private:
+	struct Entry {
+		std::uint64_t generation{};
+		TextHeight height{};
+		std::string text{};
+		float n_line_height{};
+		std::size_t hash{};
+		Layout layout{};
+	};
+
+	using List = std::list<Entry>;
+
+	void evict(std::size_t count);
+
+	std::size_t m_capacity;
+	// most recently used at the front.
+	List m_entries{};
+	std::unordered_map<std::size_t, List::iterator> m_map{};
+	Stats m_stats{};
+};
+} // namespace le
@@ -4,5 +4,9 @@
 
 namespace le::util {
 [[nodiscard]] auto clamp(TextHeight height) -> TextHeight;
+/// \brief Append a GlyphInstance per glyph.
+/// \param scale Scale applied to glyph layouts, before offsetting by position.
+void write_glyph_instances(std::vector<GlyphInstance>& out, std::span<kvf::ttf::GlyphLayout const> glyphs, glm::vec2 position = {},
+						   kvf::Color color = kvf::white_v, float scale = 1.0f);
 void write_glyphs(VertexArray& out, std::span<kvf::ttf::GlyphLayout const> glyphs, glm::vec2 position = {}, kvf::Color color = kvf::white_v);
 } // namespace le::util
@@ -1,12 +1,57 @@
 #pragma once
+#include <glm/common.hpp>
+#include <glm/ext/vector_uint2_sized.hpp>
+#include <glm/ext/vector_uint4_sized.hpp>
 #include <glm/vec2.hpp>
 #include <glm/vec4.hpp>
+#include <cstdint>
 
 namespace le {
+/// \brief Layout of vertices in a vertex buffer.
+enum class VertexFormat : std::int8_t {
+	/// \brief Vertex (32 bytes).
+	Standard,
+	/// \brief PackedVertex (16 bytes).
+	Packed,
+};
+
 /// \brief Drawable vertex.
 struct Vertex {
 	glm::vec2 position{};
 	glm::vec4 color{1.0f};
 	glm::vec2 uv{};
 };
+
+/// \brief Drawable vertex with normalized integer color and UVs.
+/// Color channels are quantized to 8 bits (in linear space), UVs to 16 bits and clamped to [0, 1].
+/// UVs outside [0, 1] (eg repeating / tiled textures) cannot be represented: geometry only packs vertices that pass can_pack(),
+/// and falls back to VertexFormat::Standard otherwise.
+struct PackedVertex {
+	glm::vec2 position{};
+	glm::u16vec2 uv{};
+	glm::u8vec4 color{0xff};
+
+	/// \returns true if vertex.uv is representable (within [0, 1]).
+	[[nodiscard]] static constexpr auto can_pack(Vertex const& vertex) -> bool {
+		return vertex.uv.x >= 0.0f && vertex.uv.x <= 1.0f && vertex.uv.y >= 0.0f && vertex.uv.y <= 1.0f;
+	}
+
+	[[nodiscard]] static auto pack(Vertex const& vertex) -> PackedVertex {
+		return PackedVertex{
+			.position = vertex.position,
+			.uv = glm::u16vec2(glm::clamp(vertex.uv, 0.0f, 1.0f) * 65535.0f + 0.5f),
+			.color = glm::u8vec4(glm::clamp(vertex.color, 0.0f, 1.0f) * 255.0f + 0.5f),
+		};
+	}
+
+	[[nodiscard]] auto unpack() const -> Vertex {
+		return Vertex{
+			.position = position,
+			.color = glm::vec4(color) / 255.0f,
+			.uv = glm::vec2(uv) / 65535.0f,
+		};
+	}
+};
+
+static_assert(sizeof(PackedVertex) == 16);
 } // namespace le
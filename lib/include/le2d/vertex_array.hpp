@@ -1,4 +1,5 @@
 #pragma once
+#include "le2d/glyph_instance.hpp"
 #include "le2d/vertex.hpp"
 #include <cstdint>
 #include <span>
@@ -6,12 +7,37 @@
 
 namespace le {
 /// \brief Drawable vertex array.
-struct VertexArray {
-	std::vector<Vertex> vertices{};
+template <typename VertexT>
+struct BasicVertexArray {
+	std::vector<VertexT> vertices{};
 	std::vector<std::uint32_t> indices{};
 
 	void reserve(std::size_t vertex_count, std::size_t index_count);
 	void clear();
-	auto append(std::span<Vertex const> vertices, std::span<std::uint32_t const> indices) -> VertexArray&;
+	auto append(std::span<VertexT const> vertices, std::span<std::uint32_t const> indices) -> BasicVertexArray&;
 };
+
+extern template struct BasicVertexArray<Vertex>;
+extern template struct BasicVertexArray<PackedVertex>;
+
+using VertexArray = BasicVertexArray<Vertex>;
+using PackedVertexArray = BasicVertexArray<PackedVertex>;
+
+/// \brief Append packed copies of in to out.
+void pack_vertices(std::vector<PackedVertex>& out, std::span<Vertex const> in);
+/// \brief Append unpacked copies of in to out.
+void unpack_vertices(std::vector<Vertex>& out, std::span<PackedVertex const> in);
+/// \brief Append the quad vertices of each glyph in in to out, laid out for shape::Quad::list_indices().
+void unpack_glyphs(std::vector<Vertex>& out, std::span<GlyphInstance const> in);
+/// \brief Append the packed quad vertices of each glyph in in to out, laid out for shape::Quad::list_indices().
+void unpack_glyphs(std::vector<PackedVertex>& out, std::span<GlyphInstance const> in);
+/// \returns true if every vertex passes PackedVertex::can_pack().
+[[nodiscard]] auto can_pack(std::span<Vertex const> vertices) -> bool;
+
+/// \brief Store vertices in a single format: moves them into packed if format is Packed and can_pack(vertices), else into vertices.
+/// \param format Requested format.
+/// \param vertices Standard vertices (cleared if packed).
+/// \param packed Packed vertices (cleared if not packed).
+/// \returns Format the vertices are stored in.
+auto store_vertices(VertexFormat format, std::vector<Vertex>& vertices, std::vector<PackedVertex>& packed) -> VertexFormat;
 } // namespace le
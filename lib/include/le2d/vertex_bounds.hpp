@@ -1,9 +1,16 @@
 #pragma once
 #include "kvf/rect.hpp"
+#include "le2d/glyph_instance.hpp"
 #include "le2d/vertex.hpp"
 #include <glm/mat4x4.hpp>
 #include <span>
 
 namespace le {
 [[nodiscard]] auto vertex_bounds(std::span<Vertex const> vertices, glm::mat4 const& model) -> kvf::Rect<>;
+[[nodiscard]] auto vertex_bounds(std::span<PackedVertex const> vertices, glm::mat4 const& model) -> kvf::Rect<>;
+[[nodiscard]] auto vertex_bounds(std::span<GlyphInstance const> glyphs, glm::mat4 const& model) -> kvf::Rect<>;
+/// \returns Axis-aligned bounds of rect transformed by model.
+[[nodiscard]] auto rect_bounds(kvf::Rect<> const& rect, glm::mat4 const& model) -> kvf::Rect<>;
+/// \returns true if a and b overlap (or touch).
+[[nodiscard]] auto intersects(kvf::Rect<> const& a, kvf::Rect<> const& b) -> bool;
 } // namespace le
@@ -68,7 +68,8 @@ auto ShaderLoader::load_asset(std::string_view const uri) const -> std::unique_p
 	auto const vert = m_data_loader->load_spir_v(json["vertex"].as_string_view());
 	auto const frag = m_data_loader->load_spir_v(json["fragment"].as_string_view());
 	if (vert.empty() || frag.empty()) { return {}; }
-	return m_resource_factory->create_shader(vert, frag);
+	auto const instance_format = json["instance_format"].as_string_view() == "compact" ? InstanceFormat::Compact : InstanceFormat::Std430;
+	return m_resource_factory->create_shader(vert, frag, instance_format);
 }
 
 auto FontLoader::load_asset(std::string_view const uri) const -> std::unique_ptr<IFont> {
@@ -1,5 +1,6 @@
 #include "le2d/asset/manifest_loader.hpp"
 #include "klib/task/queue.hpp"
+#include "le2d/profile.hpp"
 #include <atomic>
 
 namespace le {
@@ -28,6 +29,7 @@ class LoadTask : public klib::task::Task {
 
   private:
 	void execute() final {
+		LE_PROFILE_ZONE("ManifestLoader::load_asset");
 		m_asset = m_loader->load_asset(m_entry.get_type(), m_entry.uri.get_string());
 		if (m_asset) {
 			++m_progress->loaded;
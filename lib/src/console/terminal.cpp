@@ -49,11 +49,7 @@ struct Buffer {
 
 	[[nodiscard]] auto get_height() const -> float { return m_text_buffer.get_size().y; }
 
-	void draw(IRenderer& renderer) const {
-		auto const primitive = m_text_buffer.to_primitive();
-		auto const instance = RenderInstance{.transform = {.position = position}};
-		renderer.draw(primitive, {&instance, 1});
-	}
+	void draw(IRenderer& renderer) const { m_text_buffer.draw(renderer, RenderInstance{.transform = {.position = position}}); }
 
 	glm::vec2 position{};
 
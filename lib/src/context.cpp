@@ -3,6 +3,7 @@
 #include "klib/debug/assert.hpp"
 #include "kvf/window.hpp"
 #include "le2d/asset/asset_type_loaders.hpp"
+#include "le2d/profile.hpp"
 #include <capo/engine.hpp>
 #include <log.hpp>
 #include <thread>
@@ -209,9 +210,11 @@ class ContextImpl : public Context {
 	void set_max_framerate(Framerate const framerate) final { m_max_framerate = std::max(std::int32_t(framerate), 0); }
 
 	auto next_frame() -> vk::CommandBuffer final {
+		LE_PROFILE_ZONE("Context::next_frame");
 		m_event_queue.clear();
 		m_drops.clear();
 		m_cmd = m_render_device->next_frame();
+		m_resources.deferred_release->next_frame(m_cmd);
 		process_requests();
 		update_timings_and_stats(kvf::Clock::now());
 		return m_cmd;
@@ -225,6 +228,7 @@ class ContextImpl : public Context {
 	}
 
 	void present() final {
+		LE_PROFILE_ZONE("Context::present");
 		m_renderer->end_render();
 		m_frame_finish = kvf::Clock::now();
 		m_render_device->render(m_render_pass->get_render_target());
@@ -234,6 +238,7 @@ class ContextImpl : public Context {
 	}
 
 	[[nodiscard]] auto get_frame_stats() const -> FrameStats const& final { return m_frame_stats; }
+	[[nodiscard]] auto get_gpu_timings() const -> std::span<GpuTiming const> final { return m_renderer->get_gpu_timings(); }
 
 	[[nodiscard]] auto create_render_pass(vk::SampleCountFlagBits samples) const -> std::unique_ptr<IRenderPass> final {
 		return m_resources.create_render_pass(samples);
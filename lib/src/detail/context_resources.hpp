@@ -1,4 +1,5 @@
 #pragma once
+#include "detail/deferred_release.hpp"
 #include "detail/render_resources.hpp"
 #include "le2d/audio_mixer.hpp"
 #include "le2d/render_pass.hpp"
@@ -15,6 +16,7 @@ class ContextResources {
 	std::unique_ptr<IAudioMixer> audio_mixer{};
 	std::unique_ptr<ShaderLayout> shader_layout{};
 	std::unique_ptr<ISamplerFactory> sampler_factory{};
+	std::unique_ptr<DeferredRelease> deferred_release{};
 	std::unique_ptr<IResourceFactory> resource_factory{};
 	std::unique_ptr<IRenderResources> render_resources{};
 };
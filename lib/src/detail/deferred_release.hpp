@@ -0,0 +1,53 @@
+#pragma once
+#include <vulkan/vulkan.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace le::detail {
+// keeps retired GPU resources alive until every frame in flight that may reference them has completed.
+// the render device cycles through one command buffer per buffered frame, and hands one out again only after waiting for its previous
+// submission: the frame that last used it bounds the frames that have completed, whatever the device's buffering.
+class DeferredRelease {
+  public:
+	// can be called from any thread.
+	void retire(std::shared_ptr<void> resource) {
+		if (!resource) { return; }
+		auto lock = std::scoped_lock{m_mutex};
+		m_retired.push_back(Entry{.resource = std::move(resource), .frame = m_frame});
+	}
+
+	// call once per frame, with the command buffer the render device returned for it.
+	void next_frame(vk::CommandBuffer const command_buffer) {
+		auto lock = std::scoped_lock{m_mutex};
+		++m_frame;
+		auto const it = std::ranges::find(m_frame_buffers, command_buffer, &FrameBuffer::command_buffer);
+		if (it == m_frame_buffers.end()) {
+			// first use: no frame is known to have completed yet.
+			m_frame_buffers.push_back(FrameBuffer{.command_buffer = command_buffer, .frame = m_frame});
+			return;
+		}
+		auto const completed = std::exchange(it->frame, m_frame);
+		std::erase_if(m_retired, [completed](Entry const& entry) { return entry.frame <= completed; });
+	}
+
+  private:
+	struct Entry {
+		std::shared_ptr<void> resource{};
+		std::uint64_t frame{};
+	};
+
+	struct FrameBuffer {
+		vk::CommandBuffer command_buffer{};
+		std::uint64_t frame{};
+	};
+
+	std::vector<Entry> m_retired{};
+	std::vector<FrameBuffer> m_frame_buffers{};
+	std::uint64_t m_frame{};
+	std::mutex m_mutex{};
+};
+} // namespace le::detail
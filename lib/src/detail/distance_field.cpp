@@ -0,0 +1,120 @@
+#include "detail/distance_field.hpp"
+#include <algorithm>
+#include <cmath>
+#include <span>
+
+namespace le::detail {
+namespace {
+// stands in for infinity, so that intersections of parabolas stay finite.
+constexpr auto far_v = 1e20;
+
+// squared euclidean distance transform of a row / column (Felzenszwalb & Huttenlocher): f[q] = min over p of (q - p)^2 + f[p].
+// result is written to d, v and z are scratch storage of at least f.size() and f.size() + 1 elements.
+void transform_1d(std::span<double const> const f, std::span<double> const d, std::span<std::size_t> const v, std::span<double> const z) {
+	auto const intersection = [&](std::size_t const q, std::size_t const p) {
+		auto const dq = double(q);
+		auto const dp = double(p);
+		return ((f[q] + (dq * dq)) - (f[p] + (dp * dp))) / (2.0 * (dq - dp));
+	};
+
+	auto k = std::size_t{};
+	v[0] = 0;
+	z[0] = -far_v;
+	z[1] = far_v;
+	for (std::size_t q = 1; q < f.size(); ++q) {
+		auto s = intersection(q, v[k]);
+		while (k > 0 && s <= z[k]) {
+			--k;
+			s = intersection(q, v[k]);
+		}
+		++k;
+		v[k] = q;
+		z[k] = s;
+		z[k + 1] = far_v;
+	}
+
+	k = 0;
+	for (std::size_t q = 0; q < f.size(); ++q) {
+		while (z[k + 1] < double(q)) { ++k; }
+		auto const dq = double(q) - double(v[k]);
+		d[q] = (dq * dq) + f[v[k]];
+	}
+}
+
+class Transform2D {
+  public:
+	explicit Transform2D(glm::ivec2 const size) : m_width(std::size_t(size.x)), m_height(std::size_t(size.y)) {
+		auto const length = std::max(m_width, m_height);
+		m_f.resize(length);
+		m_d.resize(length);
+		m_v.resize(length);
+		m_z.resize(length + 1);
+	}
+
+	// grid holds squared distances to seeds (0 at seed texels, far_v away from them), replaced by squared distances to the nearest seed.
+	void operator()(std::span<double> const grid) {
+		for (std::size_t x = 0; x < m_width; ++x) {
+			for (std::size_t y = 0; y < m_height; ++y) { m_f[y] = grid[(y * m_width) + x]; }
+			transform(m_height);
+			for (std::size_t y = 0; y < m_height; ++y) { grid[(y * m_width) + x] = m_d[y]; }
+		}
+		for (std::size_t y = 0; y < m_height; ++y) {
+			auto const row = grid.subspan(y * m_width, m_width);
+			std::ranges::copy(row, m_f.begin());
+			transform(m_width);
+			std::copy_n(m_d.begin(), m_width, row.begin());
+		}
+	}
+
+  private:
+	void transform(std::size_t const length) { transform_1d(std::span{m_f}.first(length), std::span{m_d}.first(length), m_v, m_z); }
+
+	std::size_t m_width;
+	std::size_t m_height;
+	std::vector<double> m_f{};
+	std::vector<double> m_d{};
+	std::vector<std::size_t> m_v{};
+	std::vector<double> m_z{};
+};
+} // namespace
+
+auto DistanceField::build(kvf::Bitmap const& coverage, std::int32_t spread) -> DistanceField {
+	spread = std::max(spread, 1);
+	auto ret = DistanceField{};
+	if (coverage.size.x <= 0 || coverage.size.y <= 0 || coverage.bytes.size() < std::size_t(coverage.size.x) * std::size_t(coverage.size.y)) {
+		return ret;
+	}
+
+	ret.size = coverage.size + (2 * spread);
+	auto const texel_count = std::size_t(ret.size.x) * std::size_t(ret.size.y);
+	// squared distances to the nearest texel outside / inside the glyph (at least half covered).
+	auto to_outside = std::vector<double>(texel_count, 0.0);
+	auto to_inside = std::vector<double>(texel_count, far_v);
+	auto alpha = std::vector<double>(texel_count, 0.0);
+	for (std::int32_t y = 0; y < coverage.size.y; ++y) {
+		for (std::int32_t x = 0; x < coverage.size.x; ++x) {
+			auto const value = coverage.bytes[(std::size_t(y) * std::size_t(coverage.size.x)) + std::size_t(x)];
+			auto const index = (std::size_t(y + spread) * std::size_t(ret.size.x)) + std::size_t(x + spread);
+			alpha[index] = double(std::uint8_t(value)) / 255.0;
+			if (alpha[index] < 0.5) { continue; }
+			to_outside[index] = far_v;
+			to_inside[index] = 0.0;
+		}
+	}
+
+	auto transform = Transform2D{ret.size};
+	transform(to_outside);
+	transform(to_inside);
+
+	ret.pixels.resize(texel_count);
+	for (std::size_t i = 0; i < texel_count; ++i) {
+		// positive outside the glyph: edges lie halfway between the centers of texels inside and outside.
+		// partially covered texels are on an edge, their coverage locates it more precisely.
+		auto distance = to_inside[i] > 0.0 ? std::sqrt(to_inside[i]) - 0.5 : 0.5 - std::sqrt(to_outside[i]);
+		if (alpha[i] > 0.0 && alpha[i] < 1.0) { distance = 0.5 - alpha[i]; }
+		auto const normalized = std::clamp(0.5 - (0.5 * distance / double(spread)), 0.0, 1.0);
+		ret.pixels[i] = std::byte(std::uint8_t(std::lround(normalized * 255.0)));
+	}
+	return ret;
+}
+} // namespace le::detail
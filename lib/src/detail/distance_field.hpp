@@ -0,0 +1,18 @@
+#pragma once
+#include "kvf/bitmap.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace le::detail {
+// Signed distance fields built from single channel coverage bitmaps, eg rasterized glyphs.
+struct DistanceField {
+	// output texels: 0.5 on edges, 1 spread texels inside, 0 spread texels outside.
+	[[nodiscard]] static auto build(kvf::Bitmap const& coverage, std::int32_t spread) -> DistanceField;
+
+	// single channel bitmap, padded by spread texels on each side of the coverage.
+	[[nodiscard]] auto get_bitmap() const -> kvf::Bitmap { return kvf::Bitmap{.bytes = pixels, .size = size}; }
+
+	std::vector<std::byte> pixels{};
+	glm::ivec2 size{};
+};
+} // namespace le::detail
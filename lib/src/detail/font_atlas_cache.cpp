@@ -0,0 +1,113 @@
+#include "detail/font_atlas_cache.hpp"
+#include "log.hpp"
+#include <array>
+#include <cstring>
+#include <format>
+#include <type_traits>
+
+namespace le::detail {
+namespace {
+using Glyph = kvf::ttf::Glyph;
+
+static_assert(std::is_trivially_copyable_v<Glyph>);
+
+constexpr auto magic_v = std::array{std::byte{'L'}, std::byte{'E'}, std::byte{'F'}, std::byte{'A'}};
+// bump when the layout of Header or Glyph changes.
+constexpr std::uint32_t version_v{2};
+constexpr std::uint32_t rgba_channels_v{4};
+
+struct Header {
+	std::array<std::byte, 4> magic{magic_v};
+	std::uint32_t version{version_v};
+	std::uint64_t font_hash{};
+	std::uint32_t height{};
+	std::uint32_t glyph_size{sizeof(Glyph)};
+	std::uint32_t glyph_count{};
+	std::int32_t width{};
+	std::int32_t rows{};
+	// 1: coverage (always written), 4: RGBA with coverage in alpha (read for older files).
+	std::uint32_t channels{1};
+};
+
+static_assert(std::is_trivially_copyable_v<Header>);
+
+[[nodiscard]] auto get_pixel_count(Header const& header) -> std::size_t { return std::size_t(header.width) * std::size_t(header.rows); }
+} // namespace
+
+auto FontAtlasCache::hash_font(std::span<std::byte const> font_bytes) -> std::uint64_t {
+	// FNV-1a.
+	auto ret = std::uint64_t{0xcbf29ce484222325};
+	for (auto const byte : font_bytes) {
+		ret ^= std::uint64_t(byte);
+		ret *= 0x100000001b3;
+	}
+	return ret;
+}
+
+auto FontAtlasCache::load(Entry& out, TextHeight const height) const -> bool {
+	if (!m_loader || !m_loader->try_load_bytes(m_buffer, get_uri(height))) { return false; }
+
+	auto header = Header{};
+	if (m_buffer.size() < sizeof(Header)) { return false; }
+	std::memcpy(&header, m_buffer.data(), sizeof(Header));
+	if (header.magic != magic_v || header.version != version_v || header.glyph_size != sizeof(Glyph) || header.font_hash != m_font_hash ||
+		header.height != std::uint32_t(height) || header.width < 0 || header.rows < 0 || (header.channels != 1 && header.channels != rgba_channels_v)) {
+		return false;
+	}
+
+	auto const glyphs_size = std::size_t(header.glyph_count) * sizeof(Glyph);
+	auto const pixels_size = get_pixel_count(header) * header.channels;
+	if (m_buffer.size() != sizeof(Header) + glyphs_size + pixels_size) {
+		log.warn("FontAtlasCache: size mismatch in '{}'", get_uri(height));
+		return false;
+	}
+
+	auto const* data = m_buffer.data() + sizeof(Header);
+	out.glyphs.resize(header.glyph_count);
+	std::memcpy(out.glyphs.data(), data, glyphs_size);
+	data += glyphs_size;
+	if (header.channels == rgba_channels_v) {
+		// written before atlases became single channel: white texels with coverage in alpha.
+		out.pixels.resize(get_pixel_count(header));
+		for (std::size_t i = 0; i < out.pixels.size(); ++i) { out.pixels[i] = data[(i * rgba_channels_v) + 3]; }
+	} else {
+		out.pixels.assign(data, data + pixels_size);
+	}
+	out.size = {header.width, header.rows};
+	return true;
+}
+
+auto FontAtlasCache::save(Entry const& entry, TextHeight const height) const -> bool {
+	if (!m_loader) { return false; }
+
+	auto const glyphs = std::span{entry.glyphs};
+	auto const header = Header{
+		.font_hash = m_font_hash,
+		.height = std::uint32_t(height),
+		.glyph_count = std::uint32_t(glyphs.size()),
+		.width = entry.size.x,
+		.rows = entry.size.y,
+		.channels = 1,
+	};
+	if (entry.pixels.size() != get_pixel_count(header)) { return false; }
+
+	m_buffer.resize(sizeof(Header) + glyphs.size_bytes() + entry.pixels.size());
+	auto* data = m_buffer.data();
+	std::memcpy(data, &header, sizeof(Header));
+	data += sizeof(Header);
+	std::memcpy(data, glyphs.data(), glyphs.size_bytes());
+	data += glyphs.size_bytes();
+	std::memcpy(data, entry.pixels.data(), entry.pixels.size());
+
+	auto const uri = get_uri(height);
+	if (!m_loader->save_bytes(m_buffer, uri)) {
+		log.warn("FontAtlasCache: failed to save '{}'", uri);
+		return false;
+	}
+	return true;
+}
+
+auto FontAtlasCache::get_uri(TextHeight const height) const -> std::string {
+	return std::format("{}/{:016x}_{}.atlas", m_directory, m_font_hash, std::uint32_t(height));
+}
+} // namespace le::detail
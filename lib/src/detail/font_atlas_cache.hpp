@@ -0,0 +1,43 @@
+#pragma once
+#include "klib/ptr.hpp"
+#include "kvf/bitmap.hpp"
+#include "kvf/ttf.hpp"
+#include "le2d/file_data_loader.hpp"
+#include "le2d/text_height.hpp"
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace le::detail {
+// Binary files of built atlases (glyph metrics + single channel coverage), keyed by a hash of the font bytes and the height.
+class FontAtlasCache {
+  public:
+	struct Entry {
+		// single channel bitmap: one byte of coverage per texel.
+		[[nodiscard]] auto get_bitmap() const -> kvf::Bitmap { return kvf::Bitmap{.bytes = pixels, .size = size}; }
+
+		std::vector<kvf::ttf::Glyph> glyphs{};
+		std::vector<std::byte> pixels{};
+		glm::ivec2 size{};
+	};
+
+	[[nodiscard]] static auto hash_font(std::span<std::byte const> font_bytes) -> std::uint64_t;
+
+	explicit FontAtlasCache(klib::Ptr<FileDataLoader const> loader, std::string directory) : m_loader(loader), m_directory(std::move(directory)) {}
+
+	void set_font_hash(std::uint64_t const hash) { m_font_hash = hash; }
+
+	[[nodiscard]] auto load(Entry& out, TextHeight height) const -> bool;
+	auto save(Entry const& entry, TextHeight height) const -> bool;
+
+  private:
+	[[nodiscard]] auto get_uri(TextHeight height) const -> std::string;
+
+	klib::Ptr<FileDataLoader const> m_loader;
+	std::string m_directory;
+	std::uint64_t m_font_hash{};
+
+	mutable std::vector<std::byte> m_buffer{};
+};
+} // namespace le::detail
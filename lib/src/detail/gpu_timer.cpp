@@ -0,0 +1,116 @@
+#include "detail/gpu_timer.hpp"
+
+namespace le::detail {
+GpuTimer::GpuTimer(vk::PhysicalDevice const physical_device, std::uint32_t const queue_family, vk::Device const device) : m_device(device) {
+	auto const& limits = physical_device.getProperties().limits;
+	if (limits.timestampPeriod <= 0.0f) { return; }
+
+	// a queue without valid bits does not support timestamps at all.
+	auto const queue_families = physical_device.getQueueFamilyProperties();
+	if (queue_family >= queue_families.size()) { return; }
+	auto const valid_bits = queue_families[queue_family].timestampValidBits;
+	if (valid_bits == 0) { return; }
+
+	m_period = limits.timestampPeriod;
+	m_mask = valid_bits >= 64 ? ~std::uint64_t{} : (std::uint64_t{1} << valid_bits) - 1;
+}
+
+void GpuTimer::begin_pass(vk::CommandBuffer const command_buffer) {
+	m_command_buffer = {};
+	m_open.clear();
+	m_dropped = 0;
+	if (!is_supported() || !command_buffer) {
+		m_timings.clear();
+		return;
+	}
+
+	m_index = (m_index + 1) % m_slots.size();
+	auto& slot = m_slots[m_index];
+	if (slot.pending) { resolve(slot); }
+	if (!slot.pool) { slot.pool = m_device.createQueryPoolUnique(vk::QueryPoolCreateInfo{{}, vk::QueryType::eTimestamp, max_queries_v}); }
+
+	command_buffer.resetQueryPool(*slot.pool, 0, max_queries_v);
+	slot.zones.clear();
+	slot.query_count = 0;
+	slot.pending = true;
+	m_command_buffer = command_buffer;
+
+	begin_zone("pass");
+}
+
+void GpuTimer::end_pass() {
+	m_dropped = 0;
+	while (!m_open.empty()) { end_zone(); }
+	m_command_buffer = {};
+}
+
+void GpuTimer::begin_zone(std::string_view const label) {
+	if (!m_command_buffer) { return; }
+	// reserve the end query as well, so that every begun zone can be closed.
+	auto& slot = m_slots[m_index];
+	if (slot.query_count + 2 + std::uint32_t(m_open.size()) > max_queries_v) {
+		++m_dropped;
+		return;
+	}
+
+	auto const query = write_timestamp(vk::PipelineStageFlagBits::eTopOfPipe);
+	if (!query) {
+		++m_dropped;
+		return;
+	}
+	m_open.push_back(slot.zones.size());
+	slot.zones.push_back(Zone{.label = std::string{label}, .query = *query, .depth = std::int32_t(m_open.size()) - 1});
+}
+
+void GpuTimer::end_zone() {
+	if (!m_command_buffer) { return; }
+	// pair with a begin_zone() that was dropped for lack of queries.
+	if (m_dropped > 0) {
+		--m_dropped;
+		return;
+	}
+	if (m_open.empty()) { return; }
+	m_open.pop_back();
+	[[maybe_unused]] auto const query = write_timestamp(vk::PipelineStageFlagBits::eBottomOfPipe);
+}
+
+void GpuTimer::resolve(Slot& slot) {
+	slot.pending = false;
+	if (slot.query_count == 0) { return; }
+
+	m_results.resize(slot.query_count);
+	auto const result =
+		m_device.getQueryPoolResults(*slot.pool, 0, slot.query_count, m_results.size() * sizeof(std::uint64_t), m_results.data(), sizeof(std::uint64_t),
+									 vk::QueryResultFlagBits::e64);
+	// not ready: the slot's pass has not completed yet (too many in flight), drop its results rather than stall.
+	if (result != vk::Result::eSuccess) { return; }
+
+	m_timings.clear();
+	m_stack.clear();
+	auto next_zone = std::size_t{};
+	for (std::uint32_t query = 0; query < slot.query_count; ++query) {
+		auto const ticks = m_results[query] & m_mask;
+		if (next_zone < slot.zones.size() && slot.zones[next_zone].query == query) {
+			auto const& zone = slot.zones[next_zone++];
+			m_stack.push_back(Begin{.timing = m_timings.size(), .ticks = ticks});
+			m_timings.push_back(GpuTiming{.label = zone.label, .depth = zone.depth});
+			continue;
+		}
+		// zones nest, so any other query ends the innermost open zone.
+		if (m_stack.empty()) { continue; }
+		auto const begin = m_stack.back();
+		m_stack.pop_back();
+		// the counter wraps around within the valid bits.
+		auto const elapsed = (ticks - begin.ticks) & m_mask;
+		m_timings[begin.timing].duration = std::chrono::nanoseconds{std::int64_t(double(elapsed) * double(m_period))};
+	}
+}
+
+auto GpuTimer::write_timestamp(vk::PipelineStageFlagBits const stage) -> std::optional<std::uint32_t> {
+	auto& slot = m_slots[m_index];
+	if (slot.query_count >= max_queries_v) { return {}; }
+	auto const ret = slot.query_count++;
+	m_command_buffer.writeTimestamp(stage, *slot.pool, ret);
+	return ret;
+}
+} // namespace le::detail
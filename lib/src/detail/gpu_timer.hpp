@@ -0,0 +1,72 @@
+#pragma once
+#include "le2d/frame_stats.hpp"
+#include <vulkan/vulkan.hpp>
+#include <array>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace le::detail {
+// Timestamp query pools, one per pass in a ring: results are read back (without waiting) when a slot is reused.
+// Pools are created on first use, so renderers that never enable timestamps own none.
+class GpuTimer {
+  public:
+	// must exceed the number of passes in flight.
+	static constexpr std::size_t ring_size_v{8};
+	static constexpr std::uint32_t max_queries_v{128};
+
+	explicit GpuTimer(vk::PhysicalDevice physical_device, std::uint32_t queue_family, vk::Device device);
+
+	[[nodiscard]] auto is_supported() const -> bool { return m_period > 0.0f; }
+
+	// call outside a render pass instance.
+	void begin_pass(vk::CommandBuffer command_buffer);
+	void end_pass();
+
+	void begin_zone(std::string_view label);
+	void end_zone();
+
+	[[nodiscard]] auto get_timings() const -> std::span<GpuTiming const> { return m_timings; }
+
+  private:
+	struct Zone {
+		std::string label{};
+		std::uint32_t query{};
+		std::int32_t depth{};
+	};
+
+	struct Slot {
+		vk::UniqueQueryPool pool{};
+		std::vector<Zone> zones{};
+		std::uint32_t query_count{};
+		bool pending{};
+	};
+
+	struct Begin {
+		std::size_t timing{};
+		std::uint64_t ticks{};
+	};
+
+	void resolve(Slot& slot);
+	auto write_timestamp(vk::PipelineStageFlagBits stage) -> std::optional<std::uint32_t>;
+
+	vk::Device m_device;
+	float m_period{};
+	// timestampValidBits of the queue, results are only meaningful within these bits.
+	std::uint64_t m_mask{};
+
+	std::array<Slot, ring_size_v> m_slots{};
+	std::size_t m_index{};
+	vk::CommandBuffer m_command_buffer{};
+	// indices into the current slot's zones.
+	std::vector<std::size_t> m_open{};
+	// begin_zone() calls that were not recorded and still need their end_zone().
+	std::size_t m_dropped{};
+
+	std::vector<std::uint64_t> m_results{};
+	std::vector<Begin> m_stack{};
+
+	std::vector<GpuTiming> m_timings{};
+};
+} // namespace le::detail
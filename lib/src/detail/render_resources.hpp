@@ -3,6 +3,7 @@
 #include "klib/base_types.hpp"
 #include "klib/ptr.hpp"
 #include "le2d/render_instance.hpp"
+#include "le2d/resource/geometry_buffer.hpp"
 #include "le2d/resource/shader.hpp"
 #include "le2d/resource/texture.hpp"
 #include <vector>
@@ -14,11 +15,28 @@ class ISamplerFactory : public klib::Polymorphic {
 	[[nodiscard]] virtual auto get_or_create(TextureSampler const& sampler) -> vk::Sampler = 0;
 };
 
+/// \brief How a built-in shader samples its texture.
+enum class TextureKind : std::int8_t { Color, DistanceField, COUNT_ };
+
+[[nodiscard]] inline auto to_texture_kind(klib::Ptr<ITextureBase const> texture) -> TextureKind {
+	if (!texture) { return TextureKind::Color; }
+	return texture->is_distance_field() ? TextureKind::DistanceField : TextureKind::Color;
+}
+
 class IRenderResources : public klib::Polymorphic {
   public:
 	[[nodiscard]] virtual auto get_shader_layout() const -> ShaderLayout const& = 0;
 	[[nodiscard]] virtual auto get_default_shader() const -> IShader const& = 0;
+	/// \brief Variant of the default shader for an instance format and texture kind, used in its place for them.
+	/// The default shader is the variant for InstanceFormat::Std430 and TextureKind::Color.
+	[[nodiscard]] virtual auto get_builtin_shader(InstanceFormat format, TextureKind kind) const -> IShader const& = 0;
+	/// \brief Whether shader is one of the built-in shaders, whose inputs the renderer may rewrite (eg baking instances into vertices).
+	[[nodiscard]] virtual auto is_builtin(IShader const& shader) const -> bool = 0;
+	/// \brief Built-in shader for batches of color textures drawn through a texture table, null if the device does not support them.
+	[[nodiscard]] virtual auto get_texture_table_shader() const -> IShader const* = 0;
 	[[nodiscard]] virtual auto get_white_texture() const -> ITexture const& = 0;
+	/// \brief Indices for Quad::max_list_quads_v quads, matching shape::Quad::list_indices().
+	[[nodiscard]] virtual auto get_quad_index_buffer() const -> IGeometryBuffer const& = 0;
 
 	[[nodiscard]] auto descriptor_image(klib::Ptr<ITextureBase const> texture) const -> vk::DescriptorImageInfo {
 		return texture ? texture->descriptor_info() : get_white_texture().descriptor_info();
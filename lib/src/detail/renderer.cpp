@@ -3,42 +3,37 @@
 #include "klib/visitor.hpp"
 #include "kvf/render_device.hpp"
 #include "kvf/util.hpp"
+#include "le2d/instance_baker.hpp"
+#include "le2d/profile.hpp"
+#include "le2d/resource/geometry_buffer.hpp"
+#include "le2d/shape/quad.hpp"
+#include "le2d/vertex_array.hpp"
+#include "le2d/vertex_bounds.hpp"
 #include <glm/gtc/matrix_transform.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <optional>
+#include <utility>
 
 namespace le::detail {
 namespace {
-struct Std430Instance {
-	glm::mat4 transform;
-	glm::vec4 tint;
-};
+// adds its lifetime to out.
+class CpuTimer {
+  public:
+	CpuTimer(CpuTimer const&) = delete;
+	CpuTimer(CpuTimer&&) = delete;
+	CpuTimer& operator=(CpuTimer const&) = delete;
+	CpuTimer& operator=(CpuTimer&&) = delete;
 
-struct Vbo {
-	[[nodiscard]] static auto create(kvf::FixedUsageBuffer const& buffer, std::span<Vertex const> vertices, std::span<std::uint32_t const> indices) -> Vbo {
-		auto const writes = std::array{
-			kvf::BufferWrite{vertices},
-			kvf::BufferWrite{indices},
-		};
-		buffer.write_contiguous(writes);
-		return Vbo{
-			.buffer = buffer.get_buffer(),
-			.vertices = std::uint32_t(vertices.size()),
-			.indices = std::uint32_t(indices.size()),
-		};
-	}
+	explicit CpuTimer(std::chrono::nanoseconds& out) : m_out(out) {}
 
-	void draw(vk::CommandBuffer const m_cmd, std::uint32_t const instances) const {
-		m_cmd.bindVertexBuffers(0, buffer, vk::DeviceSize{});
-		if (indices == 0) {
-			m_cmd.draw(vertices, instances, 0, 0);
-		} else {
-			m_cmd.bindIndexBuffer(buffer, vertices * sizeof(Vertex), vk::IndexType::eUint32);
-			m_cmd.drawIndexed(indices, instances, 0, 0, 0);
-		}
-	}
+	~CpuTimer() { m_out += std::chrono::steady_clock::now() - m_start; }
 
-	vk::Buffer buffer{};
-	std::uint32_t vertices{};
-	std::uint32_t indices{};
+  private:
+	std::chrono::nanoseconds& m_out;
+	std::chrono::steady_clock::time_point m_start{std::chrono::steady_clock::now()};
 };
 
 constexpr auto triangle_count(std::size_t const vertices, std::size_t const indices, vk::PrimitiveTopology const topology) -> std::int64_t {
@@ -52,6 +47,72 @@ constexpr auto triangle_count(std::size_t const vertices, std::size_t const indi
 	}
 }
 
+// Strips and fans are expanded into their list equivalents so that multiple primitives can share an index stream.
+constexpr auto to_list_topology(vk::PrimitiveTopology const topology) -> std::optional<vk::PrimitiveTopology> {
+	switch (topology) {
+	case vk::PrimitiveTopology::eTriangleList:
+	case vk::PrimitiveTopology::eTriangleStrip:
+	case vk::PrimitiveTopology::eTriangleFan: return vk::PrimitiveTopology::eTriangleList;
+	case vk::PrimitiveTopology::eLineList:
+	case vk::PrimitiveTopology::eLineStrip: return vk::PrimitiveTopology::eLineList;
+	case vk::PrimitiveTopology::ePointList: return vk::PrimitiveTopology::ePointList;
+	default: return {};
+	}
+}
+
+constexpr auto list_index_count(Primitive const& primitive) -> std::size_t {
+	auto const count = primitive.indices.empty() ? primitive.vertices.size() : primitive.indices.size();
+	switch (primitive.topology) {
+	case vk::PrimitiveTopology::eTriangleStrip:
+	case vk::PrimitiveTopology::eTriangleFan: return count < 3 ? 0 : (count - 2) * 3;
+	case vk::PrimitiveTopology::eLineStrip: return count < 2 ? 0 : (count - 1) * 2;
+	default: return count;
+	}
+}
+
+// out must hold list_index_count(primitive) indices.
+void write_list_indices(std::span<std::uint32_t> const out, Primitive const& primitive, std::uint32_t const base_vertex) {
+	auto const count = primitive.indices.empty() ? primitive.vertices.size() : primitive.indices.size();
+	auto const at = [&](std::size_t const i) { return base_vertex + (primitive.indices.empty() ? std::uint32_t(i) : primitive.indices[i]); };
+	auto it = out.begin();
+	auto const push = [&it](std::initializer_list<std::uint32_t> const indices) { it = std::ranges::copy(indices, it).out; };
+	switch (primitive.topology) {
+	case vk::PrimitiveTopology::eTriangleStrip:
+		for (std::size_t i = 0; i + 2 < count; ++i) {
+			// preserve winding order of odd triangles.
+			auto const odd = (i % 2) == 1;
+			push({at(odd ? i + 1 : i), at(odd ? i : i + 1), at(i + 2)});
+		}
+		break;
+	case vk::PrimitiveTopology::eTriangleFan:
+		for (std::size_t i = 1; i + 1 < count; ++i) { push({at(0), at(i), at(i + 1)}); }
+		break;
+	case vk::PrimitiveTopology::eLineStrip:
+		for (std::size_t i = 0; i + 1 < count; ++i) { push({at(i), at(i + 1)}); }
+		break;
+	default:
+		for (std::size_t i = 0; i < count; ++i) { *it++ = at(i); }
+		break;
+	}
+	KLIB_ASSERT(it == out.end());
+}
+
+template <typename Type>
+auto as_span(std::span<std::byte> const bytes) -> std::span<Type> {
+	return {reinterpret_cast<Type*>(bytes.data()), bytes.size() / sizeof(Type)}; // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+}
+
+auto has_geometry(Primitive const& primitive) -> bool {
+	IGeometryBuffer const* geometry_buffer = primitive.geometry_buffer;
+	if (geometry_buffer != nullptr) { return geometry_buffer->is_loaded(); }
+	return primitive.get_vertex_count() > 0 || !primitive.glyphs.empty();
+}
+
+// true if indices view the storage mirrored by IRenderResources::get_quad_index_buffer().
+auto is_quad_list(std::span<std::uint32_t const> indices) -> bool { return !indices.empty() && indices.data() == shape::Quad::list_indices(1).data(); }
+
+constexpr auto identity_instance_v = RenderInstance::Std430{.transform = Transform::identity_mat_v, .tint = glm::vec4{1.0f}};
+
 auto to_viewport(viewport::Letterbox const& v, glm::vec2 const framebuffer_size) {
 	auto const world_in_fb_space = v.fill_target_space(framebuffer_size);
 	auto const half_excess = 0.5f * (framebuffer_size - world_in_fb_space);
@@ -60,25 +121,66 @@ auto to_viewport(viewport::Letterbox const& v, glm::vec2 const framebuffer_size)
 	return vk::Viewport{rect.lt.x, rect.rb.y, vp_size.x, -vp_size.y};
 }
 
+// one buffer per pass stream, indexed by Renderer::Stream.
 auto const scratch_buffer_layout = std::vector<vk::BufferUsageFlags>{
-	vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eIndexBuffer,
-	vk::BufferUsageFlagBits::eUniformBuffer,
+	vk::BufferUsageFlagBits::eVertexBuffer,
+	vk::BufferUsageFlagBits::eIndexBuffer,
+	vk::BufferUsageFlagBits::eStorageBuffer,
+	vk::BufferUsageFlagBits::eStorageBuffer,
 	vk::BufferUsageFlagBits::eStorageBuffer,
 	vk::BufferUsageFlagBits::eStorageBuffer,
+	vk::BufferUsageFlagBits::eUniformBuffer,
 };
+
+// satisfies vertex attribute alignment of every vertex format.
+constexpr std::size_t geometry_align_v{16};
+
+// smallest buffer a stream grows to, avoids reallocating for each of the first few draws.
+constexpr vk::DeviceSize min_stream_capacity_v{16 * 1024};
+
+// bounds the linear search through views uploaded in a pass.
+constexpr std::size_t max_view_search_v{16};
+
+auto const user_buffer_layout = std::vector<vk::BufferUsageFlags>{vk::BufferUsageFlagBits::eStorageBuffer};
 } // namespace
 
 Renderer::Renderer(gsl::not_null<kvf::IRenderPass*> render_pass, gsl::not_null<IRenderResources*> resources)
 	: m_render_pass(render_pass), m_resources(resources),
 	  m_buffer_allocator(kvf::IRingBufferAllocator::create(&render_pass->get_render_device(), scratch_buffer_layout)),
-	  m_descriptor_allocator(&render_pass->get_render_device().get_descriptor_allocator()), m_shader(&resources->get_default_shader()) {}
+	  m_user_allocator(kvf::IRingBufferAllocator::create(&render_pass->get_render_device(), user_buffer_layout)),
+	  m_descriptor_allocator(&render_pass->get_render_device().get_descriptor_allocator()), m_shader(&resources->get_default_shader()),
+	  m_gpu_timer(render_pass->get_render_device().get_gpu().device, render_pass->get_render_device().get_gpu().queue_family,
+				  render_pass->get_render_device().get_device()) {
+	auto const& limits = render_pass->get_render_device().get_gpu().properties.limits;
+	auto const align = std::max(limits.minUniformBufferOffsetAlignment, vk::DeviceSize{1});
+	m_view_stride = (sizeof(Std430View) + align - 1) / align * align;
+	m_storage_align = std::max(limits.minStorageBufferOffsetAlignment, vk::DeviceSize{1});
+	m_max_instance_bytes = limits.maxStorageBufferRange;
+}
+
+void Renderer::flush() {
+	if (!is_rendering()) { return; }
+	// record pending draws, so that commands recorded by the caller follow them.
+	submit_pass();
+	// the caller may bind anything, stop tracking bound state.
+	m_bound = {};
+}
 
 auto Renderer::begin_render(vk::CommandBuffer const command_buffer, glm::ivec2 size, kvf::Color const clear) -> bool {
 	m_stats = {};
 	if (!command_buffer || is_rendering()) { return false; }
 
+	m_batch.clear();
+	m_pass.clear();
+	m_sets = {};
+	m_bound = {};
+	m_forked = m_replayed = 0;
+
 	size = clamp_size(size);
 
+	// query pools must be reset outside the render pass instance.
+	m_gpu_timer.begin_pass(gpu_timestamps ? command_buffer : vk::CommandBuffer{});
+
 	m_render_pass->clear_color = clear.to_linear();
 	m_render_pass->begin_render(command_buffer, kvf::util::to_vk_extent(size));
 
@@ -89,6 +191,9 @@ auto Renderer::begin_render(vk::CommandBuffer const command_buffer, glm::ivec2 s
 
 auto Renderer::end_render() -> kvf::RenderTarget const& {
 	if (is_rendering()) {
+		submit_pass();
+		m_forked = m_replayed = 0;
+		m_gpu_timer.end_pass();
 		m_rt = m_render_pass->render_target();
 		m_render_pass->end_render();
 	}
@@ -97,17 +202,39 @@ auto Renderer::end_render() -> kvf::RenderTarget const& {
 
 void Renderer::set_line_width(float width) {
 	width = std::clamp(width, 0.0f, m_render_pass->get_render_device().get_gpu().properties.limits.lineWidthRange[1]);
+	if (width == m_line_width) { return; }
+	flush_batch();
 	m_line_width = width;
 }
 
+void Renderer::set_shader(IShader const& shader) {
+	if (&shader == m_shader) { return; }
+	flush_batch();
+	m_shader = &shader;
+}
+
+void Renderer::set_user_data(UserDrawData const& user_data) {
+	flush_batch();
+	m_user_data = user_data;
+	m_sets.user = vk::DescriptorSet{};
+}
+
 void Renderer::set_view(Transform const& view) {
+	if (view.to_view() == m_view_matrices.mat_v) {
+		m_view_transform = view;
+		return;
+	}
+	flush_batch();
 	m_view_transform = view;
 	refresh_view_matrix();
+	m_sets.view.reset();
 }
 
 void Renderer::set_viewport(Viewport const& viewport) {
+	flush_batch();
 	m_viewport = viewport;
 	refresh_projection_matrix();
+	m_sets.view.reset();
 }
 
 void Renderer::draw(Primitive const& primitive, std::span<RenderInstance const> instances) {
@@ -116,63 +243,540 @@ void Renderer::draw(Primitive const& primitive, std::span<RenderInstance const>
 }
 
 void Renderer::draw_baked(Primitive const& primitive, std::span<RenderInstance::Std430 const> instances) {
-	auto const cmd = m_render_pass->get_command_buffer();
-	if (!cmd || primitive.vertices.empty() || instances.empty()) { return; }
+	if (!is_rendering() || instances.empty() || !has_geometry(primitive)) { return; }
+	if (!primitive.glyphs.empty() && primitive.geometry_buffer == nullptr) {
+		draw_glyphs(primitive, instances);
+		return;
+	}
 
-	auto descriptor_sets = std::array<vk::DescriptorSet, 3>{};
-	if (!allocate_sets(descriptor_sets)) { return; }
+	LE_PROFILE_ZONE("Renderer::draw_baked");
+	auto const timer = CpuTimer{m_stats.draw_time};
 
-	auto const visitor = klib::Visitor{
-		[this](viewport::Dynamic const& v) { return m_render_pass->to_viewport(v.n_rect); },
-		[this](viewport::Letterbox const& v) { return to_viewport(v, framebuffer_size()); },
+	auto state = to_draw_state(primitive);
+	auto const list_topology = to_list_topology(primitive.topology);
+	if (!batch_draws || !list_topology || primitive.geometry_buffer != nullptr || state.vertex_format != VertexFormat::Standard) {
+		flush_batch();
+		if (record_single(primitive, instances, {})) { count_draw(primitive, instances.size()); }
+		return;
+	}
+
+	state.topology = *list_topology;
+	// color textures of the default shader can share a batch through a texture table.
+	auto const* texture_table_shader = m_resources->get_texture_table_shader();
+	auto const texture_table = merge_textures && texture_table_shader != nullptr && state.shader == &m_resources->get_default_shader();
+	if (texture_table) { state.shader = texture_table_shader; }
+	if (!m_batch.is_empty() && (m_batch.state != state || !m_batch.can_index(primitive.texture))) { flush_batch(); }
+	auto const merged = !m_batch.is_empty();
+	if (!merged) {
+		m_batch.state = state;
+		m_batch.bake_single = m_resources->is_builtin(*m_shader);
+		m_batch.texture_table = texture_table;
+	}
+	if (!append_to_batch(primitive, instances)) { return; }
+	if (merged) { ++m_stats.merged_draws; }
+	count_draw(primitive, instances.size());
+}
+
+void Renderer::draw_compact(Primitive const& primitive, std::span<RenderInstance::Compact const> instances) {
+	// the default shader has a built-in compact variant (see to_draw_state()).
+	auto const compact = m_shader == &m_resources->get_default_shader() || m_shader->get_instance_format() == InstanceFormat::Compact;
+	if (!compact || !primitive.glyphs.empty()) {
+		draw_baked(primitive, bake_instances(instances));
+		return;
+	}
+
+	if (!is_rendering() || instances.empty() || !has_geometry(primitive)) { return; }
+	auto const timer = CpuTimer{m_stats.draw_time};
+	flush_batch();
+	if (record_single(primitive, {}, instances)) { count_draw(primitive, instances.size()); }
+}
+
+auto Renderer::fork() -> DrawRecorder& {
+	if (m_forked == m_recorders.size()) {
+		m_recorders.push_back(std::make_unique<DrawRecorder>());
+		m_forks.emplace_back();
+	}
+	// the recorder's draws are spliced in here, drawn with the state at this point.
+	flush_batch();
+	m_forks[m_forked].state = capture_state();
+	m_pass.commands.emplace_back(ForkPoint{.index = m_forked});
+	auto& ret = *m_recorders[m_forked++];
+	ret.clear();
+	return ret;
+}
+
+auto Renderer::get_view_rect() const -> kvf::Rect<> {
+	// inverse of the projection: the render area around the origin, then the inverse view.
+	auto const half_extent = glm::vec2{1.0f / m_view_matrices.mat_p[0].x, 1.0f / m_view_matrices.mat_p[1].y};
+	auto const render_rect = kvf::Rect<>{.lt = {-half_extent.x, half_extent.y}, .rb = {half_extent.x, -half_extent.y}};
+	return rect_bounds(render_rect, m_view_transform.to_inverse_view());
+}
+
+void Renderer::draw_culled(Primitive const& primitive, std::span<RenderInstance const> instances, kvf::Rect<> const& local_bounds) {
+	if (!is_rendering() || instances.empty()) { return; }
+
+	auto const view_rect = get_view_rect();
+	m_visible_instances.clear();
+	for (auto const& instance : instances) {
+		if (intersects(rect_bounds(local_bounds, instance.transform.to_model()), view_rect)) { m_visible_instances.push_back(instance); }
+	}
+	m_stats.culled_instances += std::int64_t(instances.size() - m_visible_instances.size());
+	draw(primitive, m_visible_instances);
+}
+
+void Renderer::begin_gpu_zone(std::string_view const label) {
+	if (!is_rendering()) { return; }
+	flush_batch();
+	m_pass.commands.emplace_back(GpuZoneBegin{.label = std::string{label}});
+}
+
+void Renderer::end_gpu_zone() {
+	if (!is_rendering()) { return; }
+	flush_batch();
+	m_pass.commands.emplace_back(GpuZoneEnd{});
+}
+
+auto Renderer::unprojector() const -> Unprojector { return Unprojector{m_viewport, m_view_transform, framebuffer_size()}; }
+
+void Renderer::count_draw(Primitive const& primitive, std::size_t const instance_count) {
+	IGeometryBuffer const* geometry_buffer = primitive.geometry_buffer;
+	++m_stats.submitted_draws;
+	m_stats.instances += std::int64_t(instance_count);
+	if (geometry_buffer != nullptr) {
+		m_stats.triangles += triangle_count(geometry_buffer->get_vertex_count(), geometry_buffer->get_index_count(), primitive.topology);
+	} else if (!primitive.glyphs.empty()) {
+		m_stats.triangles += 2 * std::int64_t(primitive.glyphs.size());
+	} else {
+		m_stats.triangles += triangle_count(primitive.get_vertex_count(), primitive.indices.size(), primitive.topology);
+	}
+}
+
+auto Renderer::to_draw_state(Primitive const& primitive, InstanceFormat const instance_format) const -> DrawState {
+	IShader const* shader = m_shader;
+	if (shader == &m_resources->get_default_shader()) {
+		// the default shader only reads Std430 instances and samples color: use its variant for the primitive's inputs.
+		shader = &m_resources->get_builtin_shader(instance_format, to_texture_kind(primitive.texture));
+	}
+	return DrawState{
+		.shader = shader,
+		// retained geometry is always in the standard format.
+		.vertex_format = primitive.geometry_buffer == nullptr ? primitive.get_vertex_format() : VertexFormat::Standard,
+		.topology = primitive.topology,
+		.polygon_mode = polygon_mode,
+		.viewport = m_vk_viewport,
+		.scissor = m_render_pass->to_scissor(scissor_rect),
+		.line_width = m_line_width,
 	};
-	m_vk_viewport = std::visit(visitor, m_viewport);
-	m_scissor = m_render_pass->to_scissor(scissor_rect);
+}
 
-	auto& render_device = m_render_pass->get_render_device();
+auto Renderer::fits_instances(Stream const stream, vk::DeviceSize const size) -> bool {
+	if (m_pass.sizes[std::size_t(stream)] + size <= m_max_instance_bytes) { return true; }
+	// the instance stream is bound whole, it cannot exceed the storage buffer range.
+	++m_stats.scratch_overflows;
+	return false;
+}
 
-	auto const scratch_buffers = m_buffer_allocator->allocate_next();
-	KLIB_ASSERT(scratch_buffers.size() == scratch_buffer_layout.size());
+auto Renderer::record_single(Primitive const& primitive, std::span<RenderInstance::Std430 const> instances,
+							 std::span<RenderInstance::Compact const> compact_instances) -> bool {
+	auto const compact = !compact_instances.empty();
+	auto const instance_stream = compact ? Stream::CompactInstances : Stream::Instances;
+	if (!fits_instances(instance_stream, compact ? compact_instances.size_bytes() : instances.size_bytes())) { return false; }
+
+	IGeometryBuffer const* geometry_buffer = primitive.geometry_buffer;
+	auto draw = PassDraw{
+		.state = to_draw_state(primitive, compact ? InstanceFormat::Compact : InstanceFormat::Std430),
+		.geometry_buffer = geometry_buffer,
+		.instance_format = compact ? InstanceFormat::Compact : InstanceFormat::Std430,
+	};
+	if (geometry_buffer != nullptr) {
+		draw.vertex_count = geometry_buffer->get_vertex_count();
+		draw.index_count = geometry_buffer->get_index_count();
+	} else {
+		if (primitive.packed_vertices.empty()) {
+			draw.vertex_offset = write_stream(Stream::Vertices, primitive.vertices, geometry_align_v);
+		} else {
+			draw.vertex_offset = write_stream(Stream::Vertices, primitive.packed_vertices, geometry_align_v);
+		}
+		draw.vertex_count = std::uint32_t(primitive.get_vertex_count());
+		draw.quad_list = is_quad_list(primitive.indices);
+		if (!draw.quad_list && !primitive.indices.empty()) { draw.index_offset = write_stream(Stream::Indices, primitive.indices); }
+		draw.index_count = std::uint32_t(primitive.indices.size());
+	}
 
-	auto const vbo = Vbo::create(scratch_buffers[0], primitive.vertices, primitive.indices);
+	auto const first_instance = compact ? write_stream(instance_stream, compact_instances) / sizeof(RenderInstance::Compact)
+										: write_stream(instance_stream, instances) / sizeof(RenderInstance::Std430);
+	auto const run = DrawRun{
+		.index_count = draw.index_count,
+		.first_instance = std::uint32_t(first_instance),
+		.instance_count = std::uint32_t(compact ? compact_instances.size() : instances.size()),
+		.texture = primitive.texture,
+	};
+	return push_draw(draw, {&run, 1});
+}
 
-	scratch_buffers[1].write(m_view_matrices);
-	auto const view_info = scratch_buffers[1].descriptor_info();
+auto Renderer::append_to_batch(Primitive const& primitive, std::span<RenderInstance::Std430 const> instances) -> bool {
+	auto const bake = instances.size() == 1 && m_batch.bake_single;
+	// runs of a texture table read textures per vertex, not from set 1.
+	auto const* run_texture = m_batch.texture_table ? nullptr : primitive.texture;
+	// consecutive baked draws of the same texture share a single run (and its identity instance).
+	auto const extend_run = bake && !m_batch.runs.empty() && m_batch.runs.back().merged && m_batch.runs.back().texture == run_texture;
+	auto const instance_bytes = extend_run ? 0 : (bake ? 1 : instances.size()) * sizeof(RenderInstance::Std430);
+	if (!fits_instances(Stream::Instances, instance_bytes)) { return false; }
+
+	auto const first = m_batch.is_empty();
+	auto const base_vertex = m_batch.vertex_count;
+	auto const first_index = m_batch.index_count;
+
+	// every vertex is a multiple of geometry_align_v in size, so aligned reservations keep the batch contiguous.
+	static_assert(sizeof(Vertex) % geometry_align_v == 0);
+	auto const vertices = reserve(Stream::Vertices, primitive.vertices.size_bytes(), geometry_align_v);
+	if (bake) {
+		// bake a lone instance into its vertices.
+		auto const& instance = instances.front();
+		auto out = as_span<Vertex>(vertices.bytes).begin();
+		for (auto const& vertex : primitive.vertices) {
+			*out++ = Vertex{
+				.position = glm::vec2{instance.transform * glm::vec4{vertex.position, 0.0f, 1.0f}},
+				.color = vertex.color * instance.tint,
+				.uv = vertex.uv,
+			};
+		}
+	} else {
+		std::memcpy(vertices.bytes.data(), primitive.vertices.data(), primitive.vertices.size_bytes());
+	}
 
-	scratch_buffers[2].write(instances);
-	auto const instance_info = scratch_buffers[2].descriptor_info();
+	auto const index_count = std::uint32_t(list_index_count(primitive));
+	auto const indices = reserve(Stream::Indices, index_count * sizeof(std::uint32_t), alignof(std::uint32_t));
+	write_list_indices(as_span<std::uint32_t>(indices.bytes), primitive, base_vertex);
+
+	if (m_batch.texture_table) {
+		// indices of consecutive reservations are contiguous, the first one is aligned to be bound at the batch's offset.
+		auto const texture_index = m_batch.to_texture_index(primitive.texture);
+		auto const align = first ? m_storage_align : alignof(std::uint32_t);
+		auto const texture_indices = reserve(Stream::TextureIndices, primitive.vertices.size() * sizeof(std::uint32_t), align);
+		std::ranges::fill(as_span<std::uint32_t>(texture_indices.bytes), texture_index);
+		if (first) { m_batch.texture_index_offset = texture_indices.offset; }
+	}
 
-	auto const texture_info = m_resources->descriptor_image(primitive.texture);
+	if (first) {
+		m_batch.vertex_offset = vertices.offset;
+		m_batch.index_offset = indices.offset;
+	}
+	m_batch.vertex_count += std::uint32_t(primitive.vertices.size());
+	m_batch.index_count += index_count;
 
-	scratch_buffers[3].write(m_user_data.ssbo);
-	auto const user_ssbo_info = scratch_buffers[3].descriptor_info();
+	if (extend_run) {
+		m_batch.runs.back().index_count += index_count;
+		return true;
+	}
 
-	auto const user_texture_info = m_resources->descriptor_image(m_user_data.texture);
+	auto const batch_instances = bake ? std::span{&identity_instance_v, 1} : instances;
+	m_batch.runs.push_back(DrawRun{
+		.first_index = first_index,
+		.index_count = index_count,
+		.first_instance = std::uint32_t(write_stream(Stream::Instances, batch_instances) / sizeof(RenderInstance::Std430)),
+		.instance_count = std::uint32_t(batch_instances.size()),
+		.texture = run_texture,
+		.merged = bake,
+	});
+	return true;
+}
 
-	auto const descriptor_writes = std::array{
-		kvf::util::ubo_write(&view_info, descriptor_sets[0], 0),		   kvf::util::ssbo_write(&instance_info, descriptor_sets[1], 0),
-		kvf::util::image_write(&texture_info, descriptor_sets[1], 1),	   kvf::util::ssbo_write(&user_ssbo_info, descriptor_sets[2], 0),
-		kvf::util::image_write(&user_texture_info, descriptor_sets[2], 1),
+auto Renderer::push_draw(PassDraw draw, std::span<DrawRun const> runs) -> bool {
+	auto const user_set = get_user_set();
+	if (!user_set) { return false; }
+
+	draw.view = get_view_index();
+	draw.user_set = user_set;
+	draw.first_run = std::uint32_t(m_pass.runs.size());
+	draw.run_count = std::uint32_t(runs.size());
+	m_pass.runs.insert(m_pass.runs.end(), runs.begin(), runs.end());
+	m_pass.commands.emplace_back(draw);
+	return true;
+}
+
+void Renderer::draw_glyphs(Primitive const& primitive, std::span<RenderInstance::Std430 const> instances) {
+	auto state = to_draw_state(primitive, InstanceFormat::Glyph);
+	if (state.shader->get_instance_format() != InstanceFormat::Glyph) {
+		draw_glyph_vertices(primitive, instances);
+		return;
+	}
+
+	LE_PROFILE_ZONE("Renderer::draw_glyphs");
+	auto const timer = CpuTimer{m_stats.draw_time};
+	flush_batch();
+	if (!fits_instances(Stream::Glyphs, primitive.glyphs.size_bytes()) || !fits_instances(Stream::Instances, instances.size_bytes())) { return; }
+
+	// each glyph is an instance of a 4 vertex strip, drawn once per instance of the draw.
+	// the shader reads the draw's instance at gl_VertexIndex / 4, so each run starts at its instance's first vertex.
+	state.topology = vk::PrimitiveTopology::eTriangleStrip;
+	auto const first_glyph = write_stream(Stream::Glyphs, primitive.glyphs, sizeof(GlyphInstance)) / sizeof(GlyphInstance);
+	auto const first_instance = write_stream(Stream::Instances, instances) / sizeof(RenderInstance::Std430);
+	m_glyph_runs.clear();
+	for (std::size_t i = 0; i < instances.size(); ++i) {
+		m_glyph_runs.push_back(DrawRun{
+			.first_vertex = std::uint32_t((first_instance + i) * GlyphInstance::vertex_count_v),
+			.first_instance = std::uint32_t(first_glyph),
+			.instance_count = std::uint32_t(primitive.glyphs.size()),
+			.texture = primitive.texture,
+		});
+	}
+	auto const draw = PassDraw{
+		.state = state,
+		.vertex_count = std::uint32_t(GlyphInstance::vertex_count_v),
+		.instance_format = InstanceFormat::Glyph,
 	};
-	render_device.get_device().updateDescriptorSets(descriptor_writes, {});
+	if (!push_draw(draw, m_glyph_runs)) { return; }
+	count_draw(primitive, instances.size());
+}
+
+void Renderer::draw_glyph_vertices(Primitive const& primitive, std::span<RenderInstance::Std430 const> instances) {
+	// custom shaders read vertices: expand glyphs into quads, in chunks that shape::Quad::list_indices() can index.
+	for (auto glyphs = primitive.glyphs; !glyphs.empty();) {
+		auto const chunk = glyphs.first(std::min(glyphs.size(), shape::Quad::max_list_quads_v));
+		glyphs = glyphs.subspan(chunk.size());
+		m_glyph_vertices.clear();
+		unpack_glyphs(m_glyph_vertices, chunk);
+		auto const quads = Primitive{
+			.vertices = m_glyph_vertices,
+			.indices = shape::Quad::list_indices(chunk.size()),
+			.texture = primitive.texture,
+		};
+		draw_baked(quads, instances);
+	}
+}
+
+auto Renderer::get_buffer(Stream const stream) -> kvf::FixedUsageBuffer& {
+	auto const index = std::size_t(stream);
+	if (m_pass.buffers.empty()) {
+		m_pass.buffers = m_buffer_allocator->allocate_next();
+		KLIB_ASSERT(m_pass.buffers.size() == scratch_buffer_layout.size());
+		// ring buffers are reused every few frames, bring each one up to the high-water mark before it is written to.
+		for (std::size_t i = 0; i < m_pass.buffers.size(); ++i) {
+			auto& buffer = m_pass.buffers[i];
+			if (buffer.get_size() < m_stream_capacity[i]) { buffer.resize(m_stream_capacity[i]); }
+		}
+	}
+	return m_pass.buffers[index];
+}
 
-	m_render_pass->bind_graphics_shader(m_shader->get_kvf_shader());
+auto Renderer::reserve(Stream const stream, vk::DeviceSize const size, vk::DeviceSize const align) -> StreamRange {
+	auto& buffer = get_buffer(stream);
+	auto& used = m_pass.sizes[std::size_t(stream)];
+	auto const offset = (used + align - 1) / align * align;
+	auto const required = offset + size;
+	if (required > buffer.get_size()) {
+		// preserve what has already been written in this pass across the reallocation.
+		auto const written = buffer.mapped_span().first(used);
+		m_grow_bytes.assign(written.begin(), written.end());
+		buffer.resize(std::max({required, 2 * buffer.get_size(), min_stream_capacity_v}));
+		if (!m_grow_bytes.empty()) { std::memcpy(buffer.mapped_span().data(), m_grow_bytes.data(), m_grow_bytes.size()); }
+		auto& capacity = m_stream_capacity[std::size_t(stream)];
+		capacity = std::max(capacity, buffer.get_size());
+		++m_stats.scratch_grows;
+	}
+	used = required;
+	m_stats.bytes_uploaded += std::int64_t(size);
+	return StreamRange{.offset = offset, .bytes = buffer.mapped_span().subspan(offset, size)};
+}
 
-	cmd.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, m_resources->get_shader_layout().get_pipeline_layout(), 0, descriptor_sets, {});
+void Renderer::flush_batch() {
+	if (m_batch.is_empty()) { return; }
+	auto draw = PassDraw{
+		.state = m_batch.state,
+		.vertex_offset = m_batch.vertex_offset,
+		.index_offset = m_batch.index_offset,
+		.vertex_count = m_batch.vertex_count,
+		.index_count = m_batch.index_count,
+		.instance_format = InstanceFormat::Std430,
+	};
+	if (m_batch.texture_table) {
+		auto table = TextureTable{
+			.offset = m_batch.texture_index_offset,
+			.size = m_pass.sizes[std::size_t(Stream::TextureIndices)] - m_batch.texture_index_offset,
+		};
+		std::ranges::copy(m_batch.textures, table.textures.begin());
+		draw.texture_table = std::uint32_t(m_pass.texture_tables.size());
+		m_pass.texture_tables.push_back(table);
+	}
+	push_draw(draw, m_batch.runs);
+	m_batch.clear();
+}
 
-	cmd.setPrimitiveTopology(primitive.topology);
-	cmd.setPolygonModeEXT(polygon_mode);
+auto Renderer::capture_state() const -> RenderState {
+	return RenderState{
+		.view = m_view_transform,
+		.viewport = m_viewport,
+		.shader = m_shader,
+		.user_data = m_user_data,
+		.scissor_rect = scissor_rect,
+		.polygon_mode = polygon_mode,
+		.line_width = m_line_width,
+	};
+}
 
-	cmd.setViewport(0, m_vk_viewport);
-	cmd.setScissor(0, m_scissor);
-	cmd.setLineWidth(m_line_width);
+void Renderer::apply_state(RenderState const& state) {
+	set_view(state.view);
+	set_viewport(state.viewport);
+	set_shader(*state.shader);
+	set_user_data(state.user_data);
+	set_line_width(state.line_width);
+	scissor_rect = state.scissor_rect;
+	polygon_mode = state.polygon_mode;
+}
 
-	vbo.draw(cmd, std::uint32_t(instances.size()));
-	++m_stats.draw_calls;
-	m_stats.triangles += triangle_count(primitive.vertices.size(), primitive.indices.size(), primitive.topology);
+void Renderer::replay_forks() {
+	if (m_replayed == m_forked) { return; }
+
+	// replayed draws are appended to the pass, each fork's range of commands is recorded at its ForkPoint.
+	auto const current = capture_state();
+	for (; m_replayed < m_forked; ++m_replayed) {
+		auto& fork = m_forks[m_replayed];
+		apply_state(fork.state);
+		fork.first_command = m_pass.commands.size();
+		m_recorders[m_replayed]->replay(*this);
+		flush_batch();
+		fork.command_count = m_pass.commands.size() - fork.first_command;
+	}
+	apply_state(current);
 }
 
-auto Renderer::unprojector() const -> Unprojector { return Unprojector{m_viewport, m_view_transform, framebuffer_size()}; }
+void Renderer::submit_pass() {
+	flush_batch();
+	auto const command_count = m_pass.commands.size();
+	replay_forks();
+	if (m_pass.commands.empty()) {
+		m_pass.clear();
+		return;
+	}
+
+	LE_PROFILE_ZONE("Renderer::submit_pass");
+	auto const timer = CpuTimer{m_stats.draw_time};
+
+	auto bytes = std::int64_t{};
+	for (auto const size : m_pass.sizes) { bytes += std::int64_t(size); }
+	m_stats.peak_scratch_bytes = std::max(m_stats.peak_scratch_bytes, bytes);
+
+	m_pass_sets.views.assign(m_pass.views.size(), vk::DescriptorSet{});
+	m_pass_sets.instances.clear();
+
+	auto const visitor = klib::Visitor{
+		[this](PassDraw const& draw) { record_draw(draw); },
+		[this](GpuZoneBegin const& zone) { m_gpu_timer.begin_zone(zone.label); },
+		[this](GpuZoneEnd const& /*zone*/) { m_gpu_timer.end_zone(); },
+		[](ForkPoint const& /*fork*/) {},
+	};
+	auto const commands = std::span{m_pass.commands};
+	for (auto const& command : commands.first(command_count)) {
+		if (auto const* fork_point = std::get_if<ForkPoint>(&command)) {
+			auto const& fork = m_forks[fork_point->index];
+			for (auto const& forked : commands.subspan(fork.first_command, fork.command_count)) { std::visit(visitor, forked); }
+			continue;
+		}
+		std::visit(visitor, command);
+	}
+
+	// views of the next pass are written to new buffers.
+	m_pass.clear();
+	m_sets.view.reset();
+}
+
+void Renderer::record_draw(PassDraw const& draw) {
+	auto const cmd = m_render_pass->get_command_buffer();
+	KLIB_ASSERT(cmd);
+
+	auto const runs = std::span{m_pass.runs}.subspan(draw.first_run, draw.run_count);
+	auto const* texture = runs.front().texture;
+	auto descriptor_sets = std::array{
+		get_view_set(draw.view),
+		get_instance_set(texture, draw.instance_format),
+		draw.user_set,
+	};
+	if (std::ranges::any_of(descriptor_sets, [](vk::DescriptorSet const set) { return !set; })) { return; }
+	auto const texture_table = draw.texture_table ? get_texture_table_set(*draw.texture_table) : vk::DescriptorSet{};
+	if (draw.texture_table && !texture_table) { return; }
+
+	bind_state(draw.state);
+	bind_sets(descriptor_sets);
+	if (texture_table) { bind_texture_table(texture_table); }
+
+	if (draw.instance_format == InstanceFormat::Glyph) {
+		// glyph shaders have no vertex input.
+	} else if (draw.geometry_buffer != nullptr) {
+		cmd.bindVertexBuffers(0, draw.geometry_buffer->get_buffer(), vk::DeviceSize{});
+		if (draw.index_count > 0) { cmd.bindIndexBuffer(draw.geometry_buffer->get_buffer(), draw.geometry_buffer->get_index_offset(), vk::IndexType::eUint32); }
+	} else {
+		cmd.bindVertexBuffers(0, m_pass.buffers[std::size_t(Stream::Vertices)].get_buffer(), draw.vertex_offset);
+		if (draw.quad_list) {
+			auto const& quad_indices = m_resources->get_quad_index_buffer();
+			cmd.bindIndexBuffer(quad_indices.get_buffer(), quad_indices.get_index_offset(), vk::IndexType::eUint32);
+		} else if (draw.index_count > 0) {
+			cmd.bindIndexBuffer(m_pass.buffers[std::size_t(Stream::Indices)].get_buffer(), draw.index_offset, vk::IndexType::eUint32);
+		}
+	}
+
+	for (auto const& run : runs) {
+		if (run.texture != texture) {
+			// runs share the uploaded streams, only the texture binding in set 1 changes.
+			descriptor_sets[1] = get_instance_set(run.texture, draw.instance_format);
+			if (!descriptor_sets[1]) { return; }
+			bind_sets(descriptor_sets);
+			texture = run.texture;
+		}
+		if (draw.index_count == 0) {
+			cmd.draw(draw.vertex_count, run.instance_count, run.first_vertex, run.first_instance);
+		} else {
+			cmd.drawIndexed(run.index_count, run.instance_count, run.first_index, 0, run.first_instance);
+		}
+		++m_stats.draw_calls;
+	}
+}
+
+void Renderer::bind_state(DrawState const& state) {
+	auto const cmd = m_render_pass->get_command_buffer();
+	auto const& shader = state.shader->get_kvf_shader(state.vertex_format);
+	if (m_bound.shader == &shader) {
+		++m_stats.state_changes_skipped;
+	} else {
+		m_render_pass->bind_graphics_shader(shader);
+		// binding a shader (re)sets dynamic state, start tracking afresh.
+		m_bound = BoundState{.shader = &shader};
+		++m_stats.state_changes;
+		++m_stats.shader_binds;
+	}
+
+	set_state(m_bound.topology, state.topology, [cmd](vk::PrimitiveTopology const topology) { cmd.setPrimitiveTopology(topology); });
+	set_state(m_bound.polygon_mode, state.polygon_mode, [cmd](vk::PolygonMode const mode) { cmd.setPolygonModeEXT(mode); });
+	set_state(m_bound.viewport, state.viewport, [cmd](vk::Viewport const& viewport) { cmd.setViewport(0, viewport); });
+	set_state(m_bound.scissor, state.scissor, [cmd](vk::Rect2D const& scissor) { cmd.setScissor(0, scissor); });
+	set_state(m_bound.line_width, state.line_width, [cmd](float const width) { cmd.setLineWidth(width); });
+}
+
+void Renderer::bind_sets(std::span<vk::DescriptorSet const, ShaderLayout::set_count_v> sets) {
+	// bind the smallest contiguous range of sets that differ from the bound ones.
+	auto first = std::size_t{};
+	while (first < sets.size() && sets[first] == m_bound.sets[first]) { ++first; }
+	if (first == sets.size()) {
+		++m_stats.state_changes_skipped;
+		return;
+	}
+	auto last = sets.size();
+	while (sets[last - 1] == m_bound.sets[last - 1]) { --last; }
+
+	auto const range = sets.subspan(first, last - first);
+	m_render_pass->get_command_buffer().bindDescriptorSets(vk::PipelineBindPoint::eGraphics, m_resources->get_shader_layout().get_pipeline_layout(),
+														   std::uint32_t(first), range, {});
+	std::ranges::copy(range, m_bound.sets.begin() + std::ptrdiff_t(first));
+	++m_stats.state_changes;
+}
+
+void Renderer::bind_texture_table(vk::DescriptorSet const set) {
+	auto const cmd = m_render_pass->get_command_buffer();
+	auto const layout = m_resources->get_shader_layout().get_pipeline_layout();
+	set_state(m_bound.texture_table, set, [cmd, layout](vk::DescriptorSet const& table) {
+		cmd.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, layout, std::uint32_t(ShaderLayout::texture_table_set_v), table, {});
+	});
+}
 
 void Renderer::refresh_view_matrices() {
 	refresh_view_matrix();
@@ -197,18 +801,160 @@ void Renderer::refresh_projection_matrix() {
 	m_view_matrices.mat_p = glm::ortho(-half_extent.x, half_extent.x, -half_extent.y, half_extent.y);
 }
 
-auto Renderer::allocate_sets(std::span<vk::DescriptorSet> out_sets) const -> bool {
+auto Renderer::allocate_set(std::size_t const index) -> vk::DescriptorSet {
 	auto const set_layouts = m_resources->get_shader_layout().get_set_layouts();
-	KLIB_ASSERT(set_layouts.size() == out_sets.size());
-	return m_descriptor_allocator->allocate_next(out_sets, set_layouts);
+	KLIB_ASSERT(index < set_layouts.size());
+	auto ret = vk::DescriptorSet{};
+	if (!m_descriptor_allocator->allocate_next({&ret, 1}, set_layouts.subspan(index, 1))) { return {}; }
+	++m_stats.descriptor_sets;
+	return ret;
+}
+
+auto Renderer::get_view_index() -> std::uint32_t {
+	if (m_sets.view) { return *m_sets.view; }
+
+	// views are often restored within a pass (eg overlays), reuse the slot if these matrices have been recorded recently.
+	auto const search_begin = m_pass.views.size() > max_view_search_v ? m_pass.views.end() - std::ptrdiff_t(max_view_search_v) : m_pass.views.begin();
+	auto const it = std::find(search_begin, m_pass.views.end(), m_view_matrices);
+	if (it != m_pass.views.end()) {
+		m_sets.view = std::uint32_t(it - m_pass.views.begin());
+	} else {
+		m_sets.view = std::uint32_t(m_pass.views.size());
+		m_pass.views.push_back(m_view_matrices);
+		// each reservation is aligned to the stride, so the view lands at index * m_view_stride.
+		write_stream(Stream::Views, std::span<Std430View const>{&m_view_matrices, 1}, m_view_stride);
+	}
+	return *m_sets.view;
+}
+
+auto Renderer::get_view_set(std::uint32_t const index) -> vk::DescriptorSet {
+	auto& ret = m_pass_sets.views.at(index);
+	if (ret) { return ret; }
+
+	ret = allocate_set(0);
+	if (!ret) { return {}; }
+
+	auto const& buffer = m_pass.buffers[std::size_t(Stream::Views)];
+	auto const view_info = vk::DescriptorBufferInfo{buffer.get_buffer(), index * m_view_stride, sizeof(Std430View)};
+	auto const descriptor_write = kvf::util::ubo_write(&view_info, ret, 0);
+	m_render_pass->get_render_device().get_device().updateDescriptorSets(descriptor_write, {});
+	++m_stats.descriptor_writes;
+	return ret;
+}
+
+auto Renderer::get_instance_set(ITextureBase const* texture, InstanceFormat const format) -> vk::DescriptorSet {
+	// every draw in a pass shares the instance streams, so set 1 only varies by texture.
+	auto& ret = m_pass_sets.instances[texture].at(std::size_t(format));
+	if (ret) { return ret; }
+
+	ret = allocate_set(1);
+	if (!ret) { return {}; }
+
+	// bind only the bytes written in this pass, the buffer may be larger (and may not be written to at all in this format).
+	auto const stream = [format] {
+		switch (format) {
+		case InstanceFormat::Compact: return Stream::CompactInstances;
+		case InstanceFormat::Glyph: return Stream::Glyphs;
+		default: return Stream::Instances;
+		}
+	}();
+	auto const buffer_info = [this](Stream const in) {
+		auto const size = m_pass.sizes[std::size_t(in)];
+		return vk::DescriptorBufferInfo{m_pass.buffers[std::size_t(in)].get_buffer(), 0, size > 0 ? size : vk::WholeSize};
+	};
+	auto const instance_info = buffer_info(stream);
+	auto const texture_info = m_resources->descriptor_image(texture);
+	// glyph shaders read the draw's instances from binding 2, other shaders ignore it.
+	auto const draw_instance_info = buffer_info(Stream::Instances);
+	auto const descriptor_writes = std::array{
+		kvf::util::ssbo_write(&instance_info, ret, 0),
+		kvf::util::image_write(&texture_info, ret, 1),
+		kvf::util::ssbo_write(&draw_instance_info, ret, 2),
+	};
+	m_render_pass->get_render_device().get_device().updateDescriptorSets(descriptor_writes, {});
+	m_stats.descriptor_writes += std::int64_t(descriptor_writes.size());
+	return ret;
+}
+
+auto Renderer::get_user_set() -> vk::DescriptorSet {
+	if (m_sets.user) { return m_sets.user; }
+
+	auto const set = allocate_set(2);
+	if (!set) { return {}; }
+
+	auto const buffers = m_user_allocator->allocate_next();
+	KLIB_ASSERT(buffers.size() == user_buffer_layout.size());
+	buffers[0].write(m_user_data.ssbo);
+	auto const ssbo_info = buffers[0].descriptor_info();
+
+	auto const texture_info = m_resources->descriptor_image(m_user_data.texture);
+
+	auto const descriptor_writes = std::array{
+		kvf::util::ssbo_write(&ssbo_info, set, 0),
+		kvf::util::image_write(&texture_info, set, 1),
+	};
+	m_render_pass->get_render_device().get_device().updateDescriptorSets(descriptor_writes, {});
+	m_stats.descriptor_writes += std::int64_t(descriptor_writes.size());
+
+	m_sets.user = set;
+	return set;
+}
+
+auto Renderer::get_texture_table_set(std::uint32_t const index) -> vk::DescriptorSet {
+	// each table is drawn by a single batch, its set is not reused.
+	auto const ret = allocate_set(ShaderLayout::texture_table_set_v);
+	if (!ret) { return {}; }
+
+	auto const& table = m_pass.texture_tables.at(index);
+	auto const indices_info = vk::DescriptorBufferInfo{m_pass.buffers[std::size_t(Stream::TextureIndices)].get_buffer(), table.offset, table.size};
+	auto texture_infos = std::array<vk::DescriptorImageInfo, ShaderLayout::texture_table_size_v>{};
+	std::ranges::transform(table.textures, texture_infos.begin(), [this](ITextureBase const* texture) { return m_resources->descriptor_image(texture); });
+	auto textures_write = vk::WriteDescriptorSet{};
+	textures_write.setDstSet(ret).setDstBinding(1).setDescriptorType(vk::DescriptorType::eCombinedImageSampler).setImageInfo(texture_infos);
+
+	auto const descriptor_writes = std::array{
+		kvf::util::ssbo_write(&indices_info, ret, 0),
+		textures_write,
+	};
+	m_render_pass->get_render_device().get_device().updateDescriptorSets(descriptor_writes, {});
+	m_stats.descriptor_writes += std::int64_t(descriptor_writes.size());
+	return ret;
 }
 
 auto Renderer::bake_instances(std::span<RenderInstance const> instances) const -> std::span<RenderInstance::Std430 const> {
-	m_resources->render_instance_buffer.clear();
-	m_resources->render_instance_buffer.reserve(instances.size());
-	for (auto const& in : instances) { m_resources->render_instance_buffer.push_back(in.to_std430()); }
+	m_resources->render_instance_buffer.resize(instances.size());
+	le::bake_instances(m_resources->render_instance_buffer, instances);
+	return m_resources->render_instance_buffer;
+}
+
+auto Renderer::bake_instances(std::span<RenderInstance::Compact const> instances) const -> std::span<RenderInstance::Std430 const> {
+	m_resources->render_instance_buffer.resize(instances.size());
+	le::bake_instances(m_resources->render_instance_buffer, instances);
 	return m_resources->render_instance_buffer;
 }
+void Renderer::Pass::clear() {
+	commands.clear();
+	runs.clear();
+	views.clear();
+	texture_tables.clear();
+	buffers = {};
+	sizes = {};
+}
+
+auto Renderer::Batch::to_texture_index(ITextureBase const* texture) -> std::uint32_t {
+	auto const it = std::ranges::find(textures, texture);
+	if (it != textures.end()) { return std::uint32_t(it - textures.begin()); }
+	KLIB_ASSERT(textures.size() < ShaderLayout::texture_table_size_v);
+	textures.push_back(texture);
+	return std::uint32_t(textures.size() - 1);
+}
+
+void Renderer::Batch::clear() {
+	vertex_offset = index_offset = texture_index_offset = 0;
+	vertex_count = index_count = 0;
+	runs.clear();
+	textures.clear();
+}
 } // namespace le::detail
 
 namespace le {
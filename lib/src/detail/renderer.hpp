@@ -1,11 +1,19 @@
 #pragma once
+#include "detail/gpu_timer.hpp"
 #include "detail/render_resources.hpp"
 #include "kvf/kvf_fwd.hpp"
 #include "kvf/render_pass.hpp"
 #include "kvf/ring_buffer_allocator.hpp"
 #include "kvf/util.hpp"
+#include "le2d/draw_recorder.hpp"
 #include "le2d/renderer.hpp"
 #include <algorithm>
+#include <array>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <variant>
 
 namespace le::detail {
 class Renderer : public IRenderer {
@@ -16,6 +24,167 @@ class Renderer : public IRenderer {
 	struct Std430View {
 		glm::mat4 mat_v{1.0f};
 		glm::mat4 mat_p{1.0f};
+
+		auto operator==(Std430View const& rhs) const -> bool = default;
+	};
+
+	// inputs that remain valid across draws until they change.
+	struct CachedSets {
+		// index into Pass::views.
+		std::optional<std::uint32_t> view{};
+		vk::DescriptorSet user{};
+	};
+
+	// last values recorded into the command buffer, nullopt / null if unknown.
+	struct BoundState {
+		kvf::IGraphicsShader const* shader{};
+		std::optional<vk::PrimitiveTopology> topology{};
+		std::optional<vk::PolygonMode> polygon_mode{};
+		std::optional<vk::Viewport> viewport{};
+		std::optional<vk::Rect2D> scissor{};
+		std::optional<float> line_width{};
+		std::array<vk::DescriptorSet, ShaderLayout::set_count_v> sets{};
+		std::optional<vk::DescriptorSet> texture_table{};
+	};
+
+	struct DrawState {
+		IShader const* shader{};
+		VertexFormat vertex_format{};
+		vk::PrimitiveTopology topology{};
+		vk::PolygonMode polygon_mode{};
+		vk::Viewport viewport{};
+		vk::Rect2D scissor{};
+		float line_width{};
+
+		auto operator==(DrawState const& rhs) const -> bool = default;
+	};
+
+	struct DrawRun {
+		std::uint32_t first_index{};
+		// only used by non-indexed draws: glyph shaders index the draw's instances with it.
+		std::uint32_t first_vertex{};
+		std::uint32_t index_count{};
+		std::uint32_t first_instance{};
+		std::uint32_t instance_count{};
+		ITextureBase const* texture{};
+		bool merged{};
+	};
+
+	// a draw whose streams have been written to the Pass buffers.
+	struct PassDraw {
+		DrawState state{};
+		std::uint32_t view{};
+		vk::DescriptorSet user_set{};
+		IGeometryBuffer const* geometry_buffer{};
+		bool quad_list{};
+		vk::DeviceSize vertex_offset{};
+		vk::DeviceSize index_offset{};
+		std::uint32_t vertex_count{};
+		std::uint32_t index_count{};
+		InstanceFormat instance_format{};
+		std::uint32_t first_run{};
+		std::uint32_t run_count{};
+		// index into Pass::texture_tables, if the draw's runs index their textures through one.
+		std::optional<std::uint32_t> texture_table{};
+	};
+
+	// texture indices of a batch's vertices (in Stream::TextureIndices), and the textures they index (null for white).
+	struct TextureTable {
+		vk::DeviceSize offset{};
+		vk::DeviceSize size{};
+		std::array<ITextureBase const*, ShaderLayout::texture_table_size_v> textures{};
+	};
+
+	struct GpuZoneBegin {
+		std::string label{};
+	};
+
+	struct GpuZoneEnd {};
+
+	// placeholder for the draws of a forked recorder.
+	struct ForkPoint {
+		std::size_t index{};
+	};
+
+	using PassCommand = std::variant<PassDraw, GpuZoneBegin, GpuZoneEnd, ForkPoint>;
+
+	// renderer state that draws are recorded with.
+	struct RenderState {
+		Transform view{};
+		Viewport viewport{};
+		IShader const* shader{};
+		UserDrawData user_data{};
+		kvf::UvRect scissor_rect{};
+		vk::PolygonMode polygon_mode{};
+		float line_width{};
+	};
+
+	struct Fork {
+		// state at fork(), applied when the recorder is replayed.
+		RenderState state{};
+		// commands appended to Pass by replaying the recorder.
+		std::size_t first_command{};
+		std::size_t command_count{};
+	};
+
+	// pass streams, each written directly into its own persistently mapped scratch buffer.
+	enum class Stream : std::int8_t { Vertices, Indices, Instances, CompactInstances, Glyphs, TextureIndices, Views, COUNT_ };
+
+	static constexpr auto stream_count_v = std::size_t(Stream::COUNT_);
+
+	// byte range reserved in a pass stream.
+	struct StreamRange {
+		vk::DeviceSize offset{};
+		std::span<std::byte> bytes{};
+	};
+
+	// everything recorded in the current pass: streams are written on record, commands are recorded in submit_pass().
+	// storage is retained across passes, so capacities track the high-water mark.
+	struct Pass {
+		void clear();
+
+		std::vector<PassCommand> commands{};
+		// first_instance is absolute within the draw's instance stream.
+		std::vector<DrawRun> runs{};
+		// views written to Stream::Views, searched to reuse slots.
+		std::vector<Std430View> views{};
+		std::vector<TextureTable> texture_tables{};
+		// scratch buffers of this pass, obtained on its first write.
+		std::span<kvf::FixedUsageBuffer> buffers{};
+		// bytes written to each stream.
+		std::array<vk::DeviceSize, stream_count_v> sizes{};
+	};
+
+	// descriptor sets for a pass' streams, written on first use.
+	struct PassSets {
+		std::vector<vk::DescriptorSet> views{};
+		// indexed by InstanceFormat.
+		std::unordered_map<ITextureBase const*, std::array<vk::DescriptorSet, 3>> instances{};
+	};
+
+	// vertices and indices of a batch are contiguous in their streams, its runs index relative to index_offset.
+	struct Batch {
+		[[nodiscard]] auto is_empty() const -> bool { return runs.empty(); }
+		// whether texture can be drawn without flushing the batch.
+		[[nodiscard]] auto can_index(ITextureBase const* texture) const -> bool {
+			return !texture_table || textures.size() < ShaderLayout::texture_table_size_v || std::ranges::find(textures, texture) != textures.end();
+		}
+		[[nodiscard]] auto to_texture_index(ITextureBase const* texture) -> std::uint32_t;
+
+		void clear();
+
+		DrawState state{};
+		// bake lone instances into vertices, only valid for built-in shaders (which read nothing else from instances).
+		bool bake_single{};
+		vk::DeviceSize vertex_offset{};
+		vk::DeviceSize index_offset{};
+		std::uint32_t vertex_count{};
+		std::uint32_t index_count{};
+		std::vector<DrawRun> runs{};
+		// runs index textures through a TextureTable: their texture is null, and they are drawn with the texture table shader.
+		bool texture_table{};
+		std::vector<ITextureBase const*> textures{};
+		vk::DeviceSize texture_index_offset{};
 	};
 
 	static constexpr auto clamp_size(glm::ivec2 in) {
@@ -29,12 +198,14 @@ class Renderer : public IRenderer {
 
 	auto begin_render(vk::CommandBuffer command_buffer, glm::ivec2 size, kvf::Color clear) -> bool final;
 	auto end_render() -> kvf::RenderTarget const& final;
+	void flush() final;
 
 	void set_line_width(float width) final;
 
-	void set_shader(IShader const& shader) final { m_shader = &shader; }
+	[[nodiscard]] auto get_shader() const -> IShader const& final { return *m_shader; }
+	void set_shader(IShader const& shader) final;
 
-	void set_user_data(UserDrawData const& user_data) final { m_user_data = user_data; }
+	void set_user_data(UserDrawData const& user_data) final;
 
 	[[nodiscard]] auto framebuffer_size() const -> glm::ivec2 final { return kvf::util::to_glm_vec<int>(m_render_pass->get_extent()); }
 	[[nodiscard]] auto get_view() const -> Transform const& final { return m_view_transform; }
@@ -44,20 +215,79 @@ class Renderer : public IRenderer {
 
 	void draw(Primitive const& primitive, std::span<RenderInstance const> instances) final;
 	void draw_baked(Primitive const& primitive, std::span<RenderInstance::Std430 const> instances) final;
+	void draw_compact(Primitive const& primitive, std::span<RenderInstance::Compact const> instances) final;
+
+	[[nodiscard]] auto fork() -> DrawRecorder& final;
+
+	[[nodiscard]] auto get_view_rect() const -> kvf::Rect<> final;
+	void draw_culled(Primitive const& primitive, std::span<RenderInstance const> instances, kvf::Rect<> const& local_bounds) final;
+
+	void begin_gpu_zone(std::string_view label) final;
+	void end_gpu_zone() final;
+	[[nodiscard]] auto get_gpu_timings() const -> std::span<GpuTiming const> final { return m_gpu_timer.get_timings(); }
 
 	[[nodiscard]] auto unprojector() const -> Unprojector final;
 
+	void count_draw(Primitive const& primitive, std::size_t instance_count);
+	[[nodiscard]] auto to_draw_state(Primitive const& primitive, InstanceFormat instance_format = InstanceFormat::Std430) const -> DrawState;
+	[[nodiscard]] auto fits_instances(Stream stream, vk::DeviceSize size) -> bool;
+	[[nodiscard]] auto record_single(Primitive const& primitive, std::span<RenderInstance::Std430 const> instances,
+									 std::span<RenderInstance::Compact const> compact_instances) -> bool;
+	[[nodiscard]] auto append_to_batch(Primitive const& primitive, std::span<RenderInstance::Std430 const> instances) -> bool;
+	auto push_draw(PassDraw draw, std::span<DrawRun const> runs) -> bool;
+	void draw_glyphs(Primitive const& primitive, std::span<RenderInstance::Std430 const> instances);
+	void draw_glyph_vertices(Primitive const& primitive, std::span<RenderInstance::Std430 const> instances);
+
+	[[nodiscard]] auto get_buffer(Stream stream) -> kvf::FixedUsageBuffer&;
+	[[nodiscard]] auto reserve(Stream stream, vk::DeviceSize size, vk::DeviceSize align) -> StreamRange;
+
+	template <typename Type>
+	auto write_stream(Stream const stream, std::span<Type const> data, vk::DeviceSize const align = alignof(Type)) -> vk::DeviceSize {
+		auto const range = reserve(stream, data.size_bytes(), align);
+		std::memcpy(range.bytes.data(), data.data(), data.size_bytes());
+		return range.offset;
+	}
+
+	[[nodiscard]] auto capture_state() const -> RenderState;
+	void apply_state(RenderState const& state);
+	void replay_forks();
+
+	void flush_batch();
+	void submit_pass();
+	void record_draw(PassDraw const& draw);
+	void bind_state(DrawState const& state);
+	void bind_sets(std::span<vk::DescriptorSet const, ShaderLayout::set_count_v> sets);
+	void bind_texture_table(vk::DescriptorSet set);
+
+	template <typename Type, typename F>
+	void set_state(std::optional<Type>& bound, Type const& value, F func) {
+		if (bound == value) {
+			++m_stats.state_changes_skipped;
+			return;
+		}
+		func(value);
+		bound = value;
+		++m_stats.state_changes;
+	}
+
 	void refresh_view_matrices();
 	void refresh_view_matrix();
 	void refresh_projection_matrix();
 
-	[[nodiscard]] auto allocate_sets(std::span<vk::DescriptorSet> out_sets) const -> bool;
+	[[nodiscard]] auto allocate_set(std::size_t index) -> vk::DescriptorSet;
+	[[nodiscard]] auto get_view_index() -> std::uint32_t;
+	[[nodiscard]] auto get_view_set(std::uint32_t index) -> vk::DescriptorSet;
+	[[nodiscard]] auto get_instance_set(ITextureBase const* texture, InstanceFormat format) -> vk::DescriptorSet;
+	[[nodiscard]] auto get_user_set() -> vk::DescriptorSet;
+	[[nodiscard]] auto get_texture_table_set(std::uint32_t index) -> vk::DescriptorSet;
 
 	[[nodiscard]] auto bake_instances(std::span<RenderInstance const> instances) const -> std::span<RenderInstance::Std430 const>;
+	[[nodiscard]] auto bake_instances(std::span<RenderInstance::Compact const> instances) const -> std::span<RenderInstance::Std430 const>;
 
 	gsl::not_null<kvf::IRenderPass*> m_render_pass;
 	gsl::not_null<IRenderResources*> m_resources;
 	std::shared_ptr<kvf::IRingBufferAllocator> m_buffer_allocator;
+	std::shared_ptr<kvf::IRingBufferAllocator> m_user_allocator;
 	gsl::not_null<kvf::IRingDescriptorAllocator*> m_descriptor_allocator;
 
 	gsl::not_null<IShader const*> m_shader;
@@ -65,11 +295,37 @@ class Renderer : public IRenderer {
 	Std430View m_view_matrices{};
 	Viewport m_viewport{viewport::Dynamic{}};
 	vk::Viewport m_vk_viewport{};
-	vk::Rect2D m_scissor{};
 	UserDrawData m_user_data{};
 
 	float m_line_width{1.0f};
 
+	vk::DeviceSize m_view_stride;
+	vk::DeviceSize m_storage_align;
+	vk::DeviceSize m_max_instance_bytes;
+
+	Batch m_batch{};
+	Pass m_pass{};
+	PassSets m_pass_sets{};
+	CachedSets m_sets{};
+	BoundState m_bound{};
+	// buffer sizes reached by each stream, applied to ring buffers as they are reused.
+	std::array<vk::DeviceSize, stream_count_v> m_stream_capacity{};
+	// holds a stream's contents while its buffer is resized.
+	std::vector<std::byte> m_grow_bytes{};
+
+	// pooled across passes to retain their storage, the first m_forked are in use, the first m_replayed of those have been replayed.
+	std::vector<std::unique_ptr<DrawRecorder>> m_recorders{};
+	std::vector<Fork> m_forks{};
+	std::size_t m_forked{};
+	std::size_t m_replayed{};
+
+	std::vector<RenderInstance> m_visible_instances{};
+	// glyphs expanded into quads, for shaders that cannot read them.
+	std::vector<Vertex> m_glyph_vertices{};
+	// runs of a glyph draw, one per instance.
+	std::vector<DrawRun> m_glyph_runs{};
+	GpuTimer m_gpu_timer;
+
 	kvf::RenderTarget m_rt{};
 	RenderStats m_stats{};
 };
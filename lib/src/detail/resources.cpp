@@ -1,19 +1,31 @@
 #include "capo/engine.hpp"
 #include "detail/cached_sampler.hpp"
 #include "detail/context_resources.hpp"
+#include "detail/distance_field.hpp"
+#include "detail/font_atlas_cache.hpp"
 #include "detail/renderer.hpp"
 #include "klib/debug/assert.hpp"
 #include "klib/hash_combine.hpp"
+#include "klib/task/queue.hpp"
 #include "kvf/device_waiter.hpp"
 #include "kvf/image_bitmap.hpp"
+#include "kvf/is_positive.hpp"
 #include "kvf/render_device.hpp"
 #include "kvf/render_image.hpp"
 #include "kvf/render_pass.hpp"
 #include "kvf/util.hpp"
 #include "le2d/error.hpp"
+#include "le2d/profile.hpp"
+#include "le2d/shape/quad.hpp"
 #include "le2d/text/util.hpp"
 #include "log.hpp"
 #include "spirv.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <format>
+#include <mutex>
 
 namespace le::detail {
 namespace {
@@ -243,6 +255,8 @@ class TextureBase {
 	void set_sampler(TextureSampler const& sampler) { m_cached_sampler.set_sampler(sampler); }
 
 	[[nodiscard]] auto get_size() const -> glm::ivec2 { return kvf::util::to_glm_vec<int>(m_texture->get_extent()); }
+	[[nodiscard]] auto is_distance_field() const -> bool { return m_distance_field; }
+	void set_distance_field(bool const distance_field) { m_distance_field = distance_field; }
 
 	[[nodiscard]] auto descriptor_info() const -> vk::DescriptorImageInfo { return m_texture->descriptor_info(m_cached_sampler.get_vk_sampler()); }
 
@@ -260,6 +274,7 @@ class TextureBase {
 
 	std::unique_ptr<kvf::IRenderImage> m_texture;
 	CachedSampler m_cached_sampler;
+	bool m_distance_field{};
 };
 
 template <std::derived_from<ITextureBase> BaseT>
@@ -271,6 +286,8 @@ class TextureImpl : public BaseT {
 
 	[[nodiscard]] auto get_image() const -> vk::ImageView final { return m_base.get_image(); }
 	[[nodiscard]] auto get_size() const -> glm::ivec2 final { return m_base.get_size(); }
+	[[nodiscard]] auto is_distance_field() const -> bool final { return m_base.is_distance_field(); }
+	void set_distance_field(bool const distance_field) { m_base.set_distance_field(distance_field); }
 
 	[[nodiscard]] auto descriptor_info() const -> vk::DescriptorImageInfo final { return m_base.descriptor_info(); }
 
@@ -291,56 +308,442 @@ using TileSheet = TextureImpl<ITileSheet>;
 
 #pragma region Font
 
+// RGBA like every other texture: single channel bitmaps are packed as white texels with the channel in alpha.
+// shared pages are packed by atlases of multiple fonts (under different face mutexes), m_mutex guards all state.
+class FontPage : public IFontPage {
+  public:
+	static constexpr std::int32_t channels_v{4};
+	// gap between packed regions, to avoid bleeding with linear filtering.
+	static constexpr std::int32_t padding_v{1};
+
+	explicit FontPage(gsl::not_null<kvf::IRenderDevice*> render_device, gsl::not_null<ISamplerFactory*> sampler_factory, glm::ivec2 const size,
+					  bool const distance_field = false)
+		: m_texture(render_device, sampler_factory) {
+		m_texture.set_distance_field(distance_field);
+		reset(size);
+	}
+
+	[[nodiscard]] auto get_texture() const -> ITexture const& final {
+		auto lock = std::scoped_lock{m_mutex};
+		flush();
+		return m_texture;
+	}
+	[[nodiscard]] auto get_occupancy() const -> float final {
+		auto lock = std::scoped_lock{m_mutex};
+		return float(m_next_y) / float(m_size.y);
+	}
+
+	[[nodiscard]] auto pack(kvf::Bitmap const& bitmap) -> std::optional<kvf::UvRect> final {
+		auto const size = bitmap.size;
+		if (size.x <= 0 || size.y <= 0 || bitmap.bytes.size() != std::size_t(size.x) * std::size_t(size.y)) { return {}; }
+
+		auto lock = std::scoped_lock{m_mutex};
+		auto const position = allocate(size);
+		if (!position) { return {}; }
+		++m_live_regions;
+
+		auto const dst_row = std::size_t(m_size.x) * channels_v;
+		for (std::int32_t y = 0; y < size.y; ++y) {
+			auto const* src = bitmap.bytes.data() + (std::size_t(y) * std::size_t(size.x));
+			auto* dst = m_pixels.data() + (std::size_t(position->y + y) * dst_row) + (std::size_t(position->x) * channels_v);
+			for (std::int32_t x = 0; x < size.x; ++x) { dst[(std::size_t(x) * channels_v) + 3] = src[x]; }
+		}
+		m_dirty = true;
+
+		auto const page_size = glm::vec2{m_size};
+		return kvf::UvRect{.lt = glm::vec2{*position} / page_size, .rb = glm::vec2{*position + size} / page_size};
+	}
+
+	void release(kvf::UvRect const& region) final {
+		auto lock = std::scoped_lock{m_mutex};
+		auto const page_size = glm::vec2{m_size};
+		auto const lt = glm::clamp(glm::ivec2{(region.lt * page_size) + 0.5f}, glm::ivec2{}, m_size);
+		auto const rb = glm::clamp(glm::ivec2{(region.rb * page_size) + 0.5f}, lt, m_size);
+		if (!kvf::is_positive(rb - lt) || m_live_regions == 0) { return; }
+
+		if (--m_live_regions == 0) {
+			// nothing is packed anymore: start over.
+			clear();
+			return;
+		}
+
+		// clear the alpha, so that a smaller bitmap packed here later does not filter with stale texels.
+		auto const dst_row = std::size_t(m_size.x) * channels_v;
+		for (auto y = lt.y; y < rb.y; ++y) {
+			auto* dst = m_pixels.data() + (std::size_t(y) * dst_row);
+			for (auto x = lt.x; x < rb.x; ++x) { dst[(std::size_t(x) * channels_v) + 3] = std::byte{}; }
+		}
+		m_dirty = true;
+		m_free.push_back(Region{.position = lt, .size = rb - lt + padding_v});
+	}
+
+	// discards all packed regions and resizes the page, only for pages owned by a single atlas.
+	void reset(glm::ivec2 const size) {
+		auto lock = std::scoped_lock{m_mutex};
+		m_size = glm::ivec2{std::max(size.x, 1), std::max(size.y, 1)};
+		clear();
+	}
+
+  private:
+	struct Shelf {
+		std::int32_t y{};
+		std::int32_t height{};
+		std::int32_t x{};
+	};
+
+	// a released region, including its padding.
+	struct Region {
+		[[nodiscard]] auto get_area() const -> std::int64_t { return std::int64_t(size.x) * std::int64_t(size.y); }
+
+		glm::ivec2 position{};
+		glm::ivec2 size{};
+	};
+
+	// callers must hold m_mutex.
+	void clear() {
+		// transparent white: filtering across a glyph's edge only fades its alpha.
+		m_pixels.assign(std::size_t(m_size.x) * std::size_t(m_size.y) * channels_v, std::byte{0xff});
+		for (std::size_t i = 3; i < m_pixels.size(); i += channels_v) { m_pixels[i] = std::byte{}; }
+		m_shelves.clear();
+		m_free.clear();
+		m_next_y = 0;
+		m_live_regions = 0;
+		m_dirty = true;
+	}
+
+	// callers must hold m_mutex.
+	auto allocate(glm::ivec2 const size) -> std::optional<glm::ivec2> {
+		auto const padded = size + padding_v;
+		if (padded.x > m_size.x) { return {}; }
+
+		// best fit: the smallest released region with room, reused whole.
+		auto free = m_free.end();
+		for (auto it = m_free.begin(); it != m_free.end(); ++it) {
+			if (it->size.x < padded.x || it->size.y < padded.y) { continue; }
+			if (free == m_free.end() || it->get_area() < free->get_area()) { free = it; }
+		}
+		if (free != m_free.end()) {
+			auto const ret = free->position;
+			*free = m_free.back();
+			m_free.pop_back();
+			return ret;
+		}
+
+		// best fit: the shortest existing shelf with room.
+		Shelf* shelf{};
+		for (auto& candidate : m_shelves) {
+			if (candidate.height < padded.y || candidate.x + padded.x > m_size.x) { continue; }
+			if (shelf == nullptr || candidate.height < shelf->height) { shelf = &candidate; }
+		}
+		if (shelf == nullptr) {
+			if (m_next_y + padded.y > m_size.y) { return {}; }
+			shelf = &m_shelves.emplace_back(Shelf{.y = m_next_y, .height = padded.y});
+			m_next_y += padded.y;
+		}
+
+		auto const ret = glm::ivec2{shelf->x, shelf->y};
+		shelf->x += padded.x;
+		return ret;
+	}
+
+	// uploads the whole page if anything was packed since the last flush, callers must hold m_mutex.
+	void flush() const {
+		if (!m_dirty) { return; }
+		LE_PROFILE_ZONE("FontPage::flush");
+		m_texture.overwrite(kvf::Bitmap{.bytes = m_pixels, .size = m_size});
+		m_dirty = false;
+	}
+
+	mutable std::mutex m_mutex{};
+	// uploads are deferred to get_texture(), which is const.
+	mutable Texture m_texture;
+	glm::ivec2 m_size{};
+	std::vector<std::byte> m_pixels{};
+	std::vector<Shelf> m_shelves{};
+	std::vector<Region> m_free{};
+	std::int32_t m_next_y{};
+	std::int32_t m_live_regions{};
+	mutable bool m_dirty{};
+};
+
+// rasterizes (or loads from cache) an atlas, callers must hold the mutex guarding face and cache.
+[[nodiscard]] auto rasterize_atlas(kvf::ttf::Typeface& face, TextHeight const height, detail::FontAtlasCache const* cache) -> detail::FontAtlasCache::Entry {
+	LE_PROFILE_ZONE("rasterize_atlas");
+	auto ret = detail::FontAtlasCache::Entry{};
+	if (cache != nullptr && cache->load(ret, height)) { return ret; }
+
+	auto ttf_atlas = face.build_atlas(std::uint32_t(height));
+	auto const bitmap = ttf_atlas.bitmap.bitmap();
+	ret.glyphs = std::move(ttf_atlas.glyphs);
+	// glyphs are rasterized as white texels with coverage in alpha, only alpha is kept.
+	ret.pixels.resize(bitmap.bytes.size() / 4);
+	for (std::size_t i = 0; i < ret.pixels.size(); ++i) { ret.pixels[i] = bitmap.bytes[(i * 4) + 3]; }
+	ret.size = bitmap.size;
+	if (cache != nullptr) { cache->save(ret, height); }
+	return ret;
+}
+
+// glyphs are those of the face's atlas, packed into a page (shared, or owned by the atlas) when built.
+// the atlas is rebuilt in place when its font's face or page changes, so pointers to it (and to its glyphs) stay valid.
 class FontAtlas : public IFontAtlas {
   public:
 	using Glyph = kvf::ttf::Glyph;
 	using GlyphLayout = kvf::ttf::GlyphLayout;
 
-	explicit FontAtlas(gsl::not_null<kvf::IRenderDevice*> render_device, gsl::not_null<ISamplerFactory*> sampler_factory)
-		: m_texture(render_device, sampler_factory) {}
+	// distance field atlases pack each glyph's field separately, into a page of their own that grows until they all fit.
+	static constexpr auto distance_field_page_size_v = glm::ivec2{1024};
 
-	void build(gsl::not_null<kvf::ttf::Typeface*> face, TextHeight height) {
-		height = util::clamp(height);
-		auto ttf_atlas = face->build_atlas(std::uint32_t(height));
-		m_texture.overwrite(ttf_atlas.bitmap.bitmap());
+	// distance field atlases always own their page: their alpha is a distance, not coverage.
+	explicit FontAtlas(gsl::not_null<kvf::IRenderDevice*> render_device, gsl::not_null<ISamplerFactory*> sampler_factory,
+					   gsl::not_null<std::mutex*> face_mutex, bool const distance_field = false)
+		: m_render_device(render_device), m_sampler_factory(sampler_factory), m_face_mutex(face_mutex), m_distance_field(distance_field) {}
 
+	// callers must hold the mutex guarding face.
+	void build(gsl::not_null<kvf::ttf::Typeface*> face, TextHeight const height, std::uint64_t const generation, detail::FontAtlasCache::Entry const& entry,
+			   IFontPage* page) {
+		LE_PROFILE_ZONE("FontAtlas::build");
+		release_region();
 		m_face = face;
 		m_height = height;
-		m_glyphs = std::move(ttf_atlas.glyphs);
+		m_generation = generation;
+
+		// existing glyphs are updated in place: layouts pointing to them remain valid.
+		for (auto& [codepoint, slot] : m_glyphs) { slot = GlyphSlot{.glyph = Glyph{.codepoint = slot.glyph.codepoint}, .missing = true}; }
+		if (m_distance_field) {
+			build_distance_field(entry);
+		} else {
+			build_coverage(entry, page);
+		}
+
+		// the face lays out text from a contiguous span of glyphs.
+		m_layout_glyphs.clear();
+		m_layout_sources.clear();
+		for (auto const& [codepoint, slot] : m_glyphs) {
+			if (slot.missing) { continue; }
+			m_layout_glyphs.push_back(slot.glyph);
+			m_layout_sources.push_back(&slot.glyph);
+		}
+	}
+
+	// releases the region packed into a shared page, if any.
+	void release_region() {
+		if (!m_region) { return; }
+		m_page->release(*m_region);
+		m_region.reset();
 	}
 
   private:
-	[[nodiscard]] auto get_glyphs() const -> std::span<Glyph const> final { return m_glyphs; }
-	[[nodiscard]] auto get_texture() const -> ITexture const& final { return m_texture; }
+	struct GlyphSlot {
+		Glyph glyph{};
+		// the face's atlas no longer has a glyph for this codepoint.
+		bool missing{};
+	};
+
+	[[nodiscard]] auto get_glyph(char32_t const codepoint) const -> Glyph const* final {
+		auto lock = std::scoped_lock{*m_face_mutex};
+		auto const it = m_glyphs.find(codepoint);
+		return it != m_glyphs.end() && !it->second.missing ? &it->second.glyph : nullptr;
+	}
+	[[nodiscard]] auto get_texture() const -> ITexture const& final { return m_page->get_texture(); }
 	[[nodiscard]] auto get_height() const -> TextHeight final { return m_height; }
+	[[nodiscard]] auto get_generation() const -> std::uint64_t final { return m_generation; }
+
+	[[nodiscard]] auto get_own_page(glm::ivec2 const size) -> FontPage& {
+		if (!m_own_page) {
+			m_own_page = std::make_unique<FontPage>(m_render_device, m_sampler_factory, size, m_distance_field);
+		} else {
+			m_own_page->reset(size);
+		}
+		return *m_own_page;
+	}
+
+	// packs the atlas' bitmap as a whole, and remaps glyph UVs into the page.
+	void build_coverage(detail::FontAtlasCache::Entry const& entry, IFontPage* page) {
+		auto const bitmap = entry.get_bitmap();
+		auto const own_page_size = bitmap.size + FontPage::padding_v;
+		m_page = page != nullptr ? page : &get_own_page(own_page_size);
+		auto uv = m_page->pack(bitmap);
+		if (uv && page != nullptr) { m_region = uv; }
+		if (!uv && page != nullptr) {
+			log.warn("FontAtlas: page full, using a dedicated page for height {}", std::uint32_t(m_height));
+			m_page = &get_own_page(own_page_size);
+			uv = m_page->pack(bitmap);
+		}
+		for (auto glyph : entry.glyphs) {
+			if (uv) {
+				auto const uv_size = uv->rb - uv->lt;
+				glyph.uv_rect.lt = uv->lt + (glyph.uv_rect.lt * uv_size);
+				glyph.uv_rect.rb = uv->lt + (glyph.uv_rect.rb * uv_size);
+			} else {
+				glyph.size = {};
+			}
+			m_glyphs[char32_t(glyph.codepoint)] = GlyphSlot{.glyph = glyph};
+		}
+	}
+
+	// builds a field per glyph from its coverage in the atlas' bitmap.
+	void build_distance_field(detail::FontAtlasCache::Entry const& entry) {
+		static constexpr auto spread_v = IFont::distance_field_spread_v;
+		auto const max_size = std::int32_t(m_render_device->get_gpu().properties.limits.maxImageDimension2D);
+		auto const bitmap_size = glm::vec2{entry.size};
+		auto page_size = distance_field_page_size_v;
+		m_fields.clear();
+		for (auto const& glyph : entry.glyphs) {
+			auto& field = m_fields.emplace_back();
+			auto const lt = glm::clamp(glm::ivec2{(glyph.uv_rect.lt * bitmap_size) + 0.5f}, glm::ivec2{}, entry.size);
+			auto const size = glm::clamp(glm::ivec2{(glyph.uv_rect.rb * bitmap_size) + 0.5f}, lt, entry.size) - lt;
+			if (!kvf::is_positive(glyph.size) || !kvf::is_positive(size)) { continue; }
+
+			m_coverage.resize(std::size_t(size.x) * std::size_t(size.y));
+			for (std::int32_t y = 0; y < size.y; ++y) {
+				auto const row = (std::size_t(lt.y + y) * std::size_t(entry.size.x)) + std::size_t(lt.x);
+				auto const src = std::span{entry.pixels}.subspan(row, std::size_t(size.x));
+				std::ranges::copy(src, m_coverage.begin() + std::ptrdiff_t(std::size_t(y) * std::size_t(size.x)));
+			}
+			// the field extends beyond the glyph's quad, so that edges are filtered across neighbouring distances.
+			field = detail::DistanceField::build(kvf::Bitmap{.bytes = m_coverage, .size = size}, spread_v);
+			page_size.x = std::max(page_size.x, field.size.x + FontPage::padding_v);
+		}
+
+		// repack everything into a taller page until it all fits.
+		page_size = glm::min(page_size, glm::ivec2{max_size});
+		while (!pack_fields(entry, page_size)) {
+			if (page_size.y >= max_size) {
+				log.warn("FontAtlas: distance field page exceeds {0}x{0}, some glyphs are missing", max_size);
+				break;
+			}
+			page_size.y = std::min(page_size.y * 2, max_size);
+		}
+	}
+
+	// packs m_fields into the own page (reset to size), returns false if any of them did not fit.
+	auto pack_fields(detail::FontAtlasCache::Entry const& entry, glm::ivec2 const size) -> bool {
+		static constexpr auto spread_v = IFont::distance_field_spread_v;
+		m_page = &get_own_page(size);
+		auto ret = true;
+		for (std::size_t i = 0; i < entry.glyphs.size(); ++i) {
+			auto glyph = entry.glyphs[i];
+			auto const& field = m_fields[i];
+			auto const uv = kvf::is_positive(field.size) ? m_page->pack(field.get_bitmap()) : std::optional<kvf::UvRect>{};
+			if (uv) {
+				auto const inset = float(spread_v) * (uv->rb - uv->lt) / glm::vec2{field.size};
+				glyph.uv_rect = kvf::UvRect{.lt = uv->lt + inset, .rb = uv->rb - inset};
+			} else {
+				ret &= !kvf::is_positive(field.size);
+				glyph.size = {};
+			}
+			m_glyphs[char32_t(glyph.codepoint)] = GlyphSlot{.glyph = glyph};
+		}
+		return ret;
+	}
 
 	auto push_layouts(std::vector<GlyphLayout>& out, std::string_view const text, float const n_line_height, bool const use_tofu) const -> glm::vec2 final {
+		LE_PROFILE_ZONE("FontAtlas::push_layouts");
+		// the face may be rasterizing another atlas on a worker thread.
+		auto lock = std::scoped_lock{*m_face_mutex};
+
 		auto const input = kvf::ttf::TextInput{
 			.text = text,
-			.glyphs = m_glyphs,
+			.glyphs = m_layout_glyphs,
 			.height = std::uint32_t(m_height),
 			.n_line_height = n_line_height,
 		};
-		return m_face->push_layouts(out, input, use_tofu);
+		auto const first = out.size();
+		auto const ret = m_face->push_layouts(out, input, use_tofu);
+
+		// point layouts at the stored glyphs, whose addresses are stable.
+		auto const layout_glyphs = std::span{m_layout_glyphs};
+		for (auto& layout : std::span{out}.subspan(first)) {
+			if (layout.glyph < layout_glyphs.data() || layout.glyph >= layout_glyphs.data() + layout_glyphs.size()) { continue; }
+			layout.glyph = m_layout_sources[std::size_t(layout.glyph - layout_glyphs.data())];
+		}
+		return ret;
 	}
 
+	gsl::not_null<kvf::IRenderDevice*> m_render_device;
+	gsl::not_null<ISamplerFactory*> m_sampler_factory;
 	klib::Ptr<kvf::ttf::Typeface> m_face{};
-	Texture m_texture;
-	std::vector<Glyph> m_glyphs{};
+	gsl::not_null<std::mutex*> m_face_mutex;
+	std::unique_ptr<FontPage> m_own_page{};
+	klib::Ptr<IFontPage> m_page{};
 	TextHeight m_height{};
+	std::uint64_t m_generation{};
+	bool m_distance_field;
+
+	// guarded by m_face_mutex. nodes are never erased, so glyph addresses are stable.
+	std::unordered_map<char32_t, GlyphSlot> m_glyphs{};
+	// copies of the glyphs in m_glyphs (which they are remapped to), passed to the face.
+	std::vector<Glyph> m_layout_glyphs{};
+	std::vector<Glyph const*> m_layout_sources{};
+	// region packed into a shared page, released on rebuild.
+	std::optional<kvf::UvRect> m_region{};
+	// scratch for a glyph's coverage, and the fields built from them.
+	std::vector<std::byte> m_coverage{};
+	std::vector<detail::DistanceField> m_fields{};
+};
+
+// rasterizes an atlas on a worker thread, the upload happens on the thread that next calls get_atlas().
+class AtlasTask : public klib::task::Task {
+  public:
+	explicit AtlasTask(gsl::not_null<kvf::ttf::Typeface*> face, gsl::not_null<std::mutex*> face_mutex, detail::FontAtlasCache const* cache,
+					   TextHeight const height)
+		: m_face(face), m_face_mutex(face_mutex), m_cache(cache), m_height(height) {}
+
+	[[nodiscard]] auto is_done() const -> bool { return m_done.load(); }
+
+	// blocks until execute() has completed.
+	[[nodiscard]] auto take_result() -> detail::FontAtlasCache::Entry {
+		m_done.wait(false);
+		return std::move(m_result);
+	}
+
+  private:
+	void execute() final {
+		LE_PROFILE_ZONE("AtlasTask::execute");
+		{
+			auto lock = std::scoped_lock{*m_face_mutex};
+			m_result = rasterize_atlas(*m_face, m_height, m_cache);
+		}
+		m_done = true;
+		m_done.notify_all();
+	}
+
+	gsl::not_null<kvf::ttf::Typeface*> m_face;
+	gsl::not_null<std::mutex*> m_face_mutex;
+	detail::FontAtlasCache const* m_cache;
+	TextHeight m_height;
+
+	detail::FontAtlasCache::Entry m_result{};
+	std::atomic<bool> m_done{};
 };
 
 class Font : public IFont {
   public:
+	Font(Font const&) = delete;
+	Font(Font&&) = delete;
+	Font& operator=(Font const&) = delete;
+	Font& operator=(Font&&) = delete;
+
 	explicit Font(gsl::not_null<kvf::IRenderDevice*> render_device, gsl::not_null<ISamplerFactory*> sampler_factory)
 		: m_render_device(render_device), m_sampler_factory(sampler_factory) {}
 
+	~Font() {
+		drain_pending();
+		for (auto& [height, atlas] : m_atlases) { atlas.release_region(); }
+	}
+
 	auto load_face(std::vector<std::byte> font_bytes) -> bool final {
+		auto const hash = detail::FontAtlasCache::hash_font(font_bytes);
 		auto face = kvf::ttf::Typeface{std::move(font_bytes)};
 		if (!face) { return false; }
 
+		auto lock = std::scoped_lock{m_mutex};
+		drain_pending();
 		m_face = std::move(face);
-		m_atlases.clear();
+		m_font_hash = hash;
+		if (m_cache) { m_cache->set_font_hash(m_font_hash); }
+		m_generation = next_generation();
+		rebuild_atlases();
 
 		return true;
 	}
@@ -350,24 +753,153 @@ class Font : public IFont {
 		return m_face.get_name();
 	}
 
+	void set_atlas_cache(klib::Ptr<FileDataLoader const> loader, std::string directory) final {
+		auto lock = std::scoped_lock{m_mutex};
+		drain_pending();
+		m_cache.reset();
+		if (!loader) { return; }
+		m_cache.emplace(loader, std::move(directory));
+		m_cache->set_font_hash(m_font_hash);
+	}
+
+	void set_page(klib::Ptr<IFontPage> page) final {
+		auto lock = std::scoped_lock{m_mutex};
+		drain_pending();
+		m_page = page;
+		m_generation = next_generation();
+		rebuild_atlases();
+	}
+
+	void prewarm(std::span<TextHeight const> heights) final {
+		KLIB_ASSERT(m_face.is_loaded());
+		auto lock = std::scoped_lock{m_mutex};
+		// atlases of a face are rasterized one at a time, a single worker suffices.
+		if (!m_queue) { m_queue = std::make_unique<klib::task::Queue>(klib::task::Queue::CreateInfo{.thread_count = klib::task::ThreadCount{1}}); }
+
+		m_enqueued.clear();
+		for (auto height : heights) {
+			height = util::clamp(height);
+			if (m_atlases.contains(height) || m_pending.contains(height)) { continue; }
+			auto task = std::make_shared<AtlasTask>(&m_face, &m_face_mutex, get_cache(), height);
+			m_enqueued.push_back(task.get());
+			m_pending.insert({height, std::move(task)});
+		}
+		if (!m_enqueued.empty()) { m_queue->enqueue(m_enqueued); }
+	}
+
+	[[nodiscard]] auto is_ready(TextHeight height) const -> bool final {
+		height = util::clamp(height);
+		auto lock = std::scoped_lock{m_mutex};
+		if (m_atlases.contains(height)) { return true; }
+		auto const it = m_pending.find(height);
+		return it != m_pending.end() && it->second->is_done();
+	}
+
 	[[nodiscard]] auto get_atlas(TextHeight height) -> FontAtlas& final {
 		KLIB_ASSERT(m_face.is_loaded());
 		height = util::clamp(height);
-		auto it = m_atlases.find(height);
-		if (it == m_atlases.end()) {
-			auto atlas = FontAtlas{m_render_device, m_sampler_factory};
-			atlas.build(&m_face, height);
-			it = m_atlases.insert({height, std::move(atlas)}).first;
+		auto task = std::shared_ptr<AtlasTask>{};
+		auto generation = std::uint64_t{};
+		auto page = klib::Ptr<IFontPage>{};
+		{
+			auto lock = std::scoped_lock{m_mutex};
+			if (auto const it = m_atlases.find(height); it != m_atlases.end()) { return it->second; }
+			generation = m_generation;
+			page = m_page;
+			if (auto node = m_pending.extract(height)) {
+				// the queue may still reference the task after it completes, keep it alive until drained.
+				task = m_retired.emplace_back(std::move(node.mapped()));
+			}
 		}
+
+		// wait / rasterize without holding m_mutex, so that is_ready() never blocks.
+		auto entry = detail::FontAtlasCache::Entry{};
+		if (task) {
+			entry = task->take_result();
+		} else {
+			auto face_lock = std::scoped_lock{m_face_mutex};
+			entry = rasterize_atlas(m_face, height, get_cache());
+		}
+		auto atlas = FontAtlas{m_render_device, m_sampler_factory, &m_face_mutex};
+		{
+			auto face_lock = std::scoped_lock{m_face_mutex};
+			atlas.build(&m_face, height, generation, entry, page);
+		}
+
+		auto lock = std::scoped_lock{m_mutex};
+		// another thread may have built the same height meanwhile, keep the first one (try_emplace() then leaves atlas untouched).
+		auto const [it, inserted] = m_atlases.try_emplace(height, std::move(atlas));
+		if (!inserted) { atlas.release_region(); }
 		return it->second;
 	}
 
+	[[nodiscard]] auto get_distance_field_atlas() -> IFontAtlas& final {
+		KLIB_ASSERT(m_face.is_loaded());
+		auto lock = std::scoped_lock{m_mutex};
+		if (!m_distance_field_atlas) {
+			m_distance_field_atlas = std::make_unique<FontAtlas>(m_render_device, m_sampler_factory, &m_face_mutex, true);
+			auto face_lock = std::scoped_lock{m_face_mutex};
+			build_distance_field_atlas();
+		}
+		return *m_distance_field_atlas;
+	}
+
+	[[nodiscard]] auto get_scaled_atlas(float const height) -> ScaledAtlas final {
+		return ScaledAtlas{.atlas = &get_distance_field_atlas(), .scale = height > 0.0f ? height / float(distance_field_height_v) : 1.0f};
+	}
+
   private:
+	// shared by all fonts, so that a generation also identifies its font.
+	[[nodiscard]] static auto next_generation() -> std::uint64_t {
+		static auto s_generation = std::atomic<std::uint64_t>{};
+		return ++s_generation;
+	}
+
+	[[nodiscard]] auto get_cache() const -> detail::FontAtlasCache const* { return m_cache ? &*m_cache : nullptr; }
+
+	// atlases handed out must outlive face / page changes, they are rebuilt in place instead of being replaced.
+	// callers must hold m_mutex.
+	void rebuild_atlases() {
+		if (m_atlases.empty() && !m_distance_field_atlas) { return; }
+		LE_PROFILE_ZONE("Font::rebuild_atlases");
+		auto face_lock = std::scoped_lock{m_face_mutex};
+		for (auto& [height, atlas] : m_atlases) { atlas.build(&m_face, height, m_generation, rasterize_atlas(m_face, height, get_cache()), m_page); }
+		if (m_distance_field_atlas) { build_distance_field_atlas(); }
+	}
+
+	// built from the coverage atlas at the same height, callers must hold m_face_mutex.
+	void build_distance_field_atlas() {
+		auto const entry = rasterize_atlas(m_face, distance_field_height_v, get_cache());
+		m_distance_field_atlas->build(&m_face, distance_field_height_v, m_generation, entry, nullptr);
+	}
+
+	void drain_pending() {
+		if (m_queue) { m_queue->drain_and_wait(); }
+		m_pending.clear();
+		m_retired.clear();
+	}
+
 	gsl::not_null<kvf::IRenderDevice*> m_render_device;
 	gsl::not_null<ISamplerFactory*> m_sampler_factory;
 
 	kvf::ttf::Typeface m_face{};
+	// guards m_face and m_cache against worker threads.
+	std::mutex m_face_mutex{};
+	std::uint64_t m_font_hash{};
+	std::optional<detail::FontAtlasCache> m_cache{};
+	klib::Ptr<IFontPage> m_page{};
+	// changes whenever m_face or m_page does.
+	std::uint64_t m_generation{next_generation()};
+
+	// guards m_atlases, m_distance_field_atlas, m_pending, and m_retired.
+	mutable std::mutex m_mutex{};
 	std::unordered_map<TextHeight, FontAtlas> m_atlases{};
+	std::unique_ptr<FontAtlas> m_distance_field_atlas{};
+	std::unordered_map<TextHeight, std::shared_ptr<AtlasTask>> m_pending{};
+	// tasks whose results have been taken, destroyed after the queue has been drained.
+	std::vector<std::shared_ptr<AtlasTask>> m_retired{};
+	std::vector<klib::task::Task*> m_enqueued{};
+	std::unique_ptr<klib::task::Queue> m_queue{};
 };
 
 #pragma endregion
@@ -376,8 +908,9 @@ class Font : public IFont {
 
 class Shader : public IShader {
   public:
-	explicit Shader(gsl::not_null<kvf::IRenderDevice*> render_device, std::span<vk::DescriptorSetLayout const> set_layouts)
-		: m_render_device(render_device), m_set_layouts(set_layouts) {}
+	explicit Shader(gsl::not_null<kvf::IRenderDevice*> render_device, std::span<vk::DescriptorSetLayout const> set_layouts,
+					InstanceFormat const instance_format)
+		: m_render_device(render_device), m_set_layouts(set_layouts), m_instance_format(instance_format) {}
 
 	[[nodiscard]] auto load(SpirV vertex, SpirV fragment) -> bool final {
 		static constexpr auto bindings_v = std::array{
@@ -390,30 +923,101 @@ class Shader : public IShader {
 			vk::VertexInputAttributeDescription2EXT{2, 0, vk::Format::eR32G32Sfloat, offsetof(Vertex, uv)},
 		};
 
-		static constexpr auto input_v = kvf::GraphicsShaderInput{
-			.bindings = bindings_v,
-			.attributes = attributes_v,
+		// normalized formats are expanded to floats by the input assembler, the same SPIR-V consumes either layout.
+		static constexpr auto packed_bindings_v = std::array{
+			vk::VertexInputBindingDescription2EXT{0, sizeof(PackedVertex), vk::VertexInputRate::eVertex, 1},
 		};
 
-		auto const shader_ci = kvf::IGraphicsShader::CreateInfo{
-			.code = {.vertex = vertex, .fragment = fragment},
-			.input = input_v,
-			.set_layouts = m_set_layouts,
+		static constexpr auto packed_attributes_v = std::array{
+			vk::VertexInputAttributeDescription2EXT{0, 0, vk::Format::eR32G32Sfloat, offsetof(PackedVertex, position)},
+			vk::VertexInputAttributeDescription2EXT{1, 0, vk::Format::eR8G8B8A8Unorm, offsetof(PackedVertex, color)},
+			vk::VertexInputAttributeDescription2EXT{2, 0, vk::Format::eR16G16Unorm, offsetof(PackedVertex, uv)},
 		};
-		m_shader = kvf::IGraphicsShader::create(m_render_device, shader_ci);
-		return m_shader != nullptr;
+
+		static constexpr auto inputs_v = std::array{
+			kvf::GraphicsShaderInput{.bindings = bindings_v, .attributes = attributes_v},
+			kvf::GraphicsShaderInput{.bindings = packed_bindings_v, .attributes = packed_attributes_v},
+		};
+
+		for (std::size_t i = 0; i < inputs_v.size(); ++i) {
+			auto const shader_ci = kvf::IGraphicsShader::CreateInfo{
+				.code = {.vertex = vertex, .fragment = fragment},
+				.input = inputs_v[i],
+				.set_layouts = m_set_layouts,
+			};
+			m_shaders[i] = kvf::IGraphicsShader::create(m_render_device, shader_ci);
+			if (!m_shaders[i]) { return false; }
+		}
+		return true;
 	}
 
   private:
-	[[nodiscard]] auto get_kvf_shader() const -> kvf::IGraphicsShader const& final {
-		KLIB_ASSERT(m_shader);
-		return *m_shader;
+	[[nodiscard]] auto get_kvf_shader(VertexFormat const format) const -> kvf::IGraphicsShader const& final {
+		auto const& ret = m_shaders.at(std::size_t(format));
+		KLIB_ASSERT(ret);
+		return *ret;
 	}
 
+	[[nodiscard]] auto get_instance_format() const -> InstanceFormat final { return m_instance_format; }
+
 	gsl::not_null<kvf::IRenderDevice*> m_render_device;
 	std::span<vk::DescriptorSetLayout const> m_set_layouts;
+	InstanceFormat m_instance_format;
+
+	// indexed by VertexFormat.
+	std::array<std::unique_ptr<kvf::IGraphicsShader>, 2> m_shaders{};
+};
+
+#pragma endregion
+
+#pragma region GeometryBuffer
+
+class GeometryBuffer : public IGeometryBuffer {
+  public:
+	static constexpr auto usage_v = vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eIndexBuffer;
+
+	GeometryBuffer(GeometryBuffer const&) = delete;
+	GeometryBuffer(GeometryBuffer&&) = delete;
+	GeometryBuffer& operator=(GeometryBuffer const&) = delete;
+	GeometryBuffer& operator=(GeometryBuffer&&) = delete;
+
+	explicit GeometryBuffer(gsl::not_null<kvf::IRenderDevice*> render_device, gsl::not_null<DeferredRelease*> deferred_release)
+		: m_render_device(render_device), m_deferred_release(deferred_release) {}
+
+	// frames in flight may still be reading the buffer.
+	~GeometryBuffer() { m_deferred_release->retire(std::move(m_buffer)); }
+
+	auto write(std::span<Vertex const> vertices, std::span<std::uint32_t const> indices) -> bool final {
+		auto const vertices_size = vertices.size_bytes();
+		if (vertices_size + indices.size_bytes() == 0) { return false; }
+
+		// the current buffer may be in use by frames in flight: write a new one, and release the old one once they have completed.
+		auto buffer = std::make_shared<kvf::FixedUsageBuffer>(m_render_device, usage_v);
+		auto const writes = std::array{kvf::BufferWrite{vertices}, kvf::BufferWrite{indices}};
+		buffer->write_contiguous(writes);
+		m_deferred_release->retire(std::move(m_buffer));
+		m_buffer = std::move(buffer);
 
-	std::unique_ptr<kvf::IGraphicsShader> m_shader{};
+		m_vertex_count = std::uint32_t(vertices.size());
+		m_index_count = std::uint32_t(indices.size());
+		m_index_offset = vertices_size;
+		return true;
+	}
+
+  private:
+	[[nodiscard]] auto get_buffer() const -> vk::Buffer final { return m_buffer ? m_buffer->get_buffer() : vk::Buffer{}; }
+	[[nodiscard]] auto get_vertex_count() const -> std::uint32_t final { return m_vertex_count; }
+	[[nodiscard]] auto get_index_count() const -> std::uint32_t final { return m_index_count; }
+	[[nodiscard]] auto get_index_offset() const -> vk::DeviceSize final { return m_index_offset; }
+
+	gsl::not_null<kvf::IRenderDevice*> m_render_device;
+	gsl::not_null<DeferredRelease*> m_deferred_release;
+
+	std::shared_ptr<kvf::FixedUsageBuffer> m_buffer{};
+
+	std::uint32_t m_vertex_count{};
+	std::uint32_t m_index_count{};
+	vk::DeviceSize m_index_offset{};
 };
 
 #pragma endregion
@@ -422,14 +1026,16 @@ class Shader : public IShader {
 
 class ResourceFactory : public IResourceFactory {
   public:
-	explicit ResourceFactory(gsl::not_null<ISamplerFactory*> sampler_factory, gsl::not_null<ShaderLayout const*> shader_layout)
-		: m_sampler_factory(sampler_factory), m_shader_layout(shader_layout) {}
+	explicit ResourceFactory(gsl::not_null<ISamplerFactory*> sampler_factory, gsl::not_null<ShaderLayout const*> shader_layout,
+							 gsl::not_null<DeferredRelease*> deferred_release)
+		: m_sampler_factory(sampler_factory), m_shader_layout(shader_layout), m_deferred_release(deferred_release) {}
 
   private:
 	[[nodiscard]] auto get_render_device() const -> kvf::IRenderDevice& final { return m_sampler_factory->get_render_device(); }
 
-	[[nodiscard]] auto create_shader(SpirV const vertex, SpirV const fragment) const -> std::unique_ptr<IShader> final {
-		auto ret = std::make_unique<Shader>(&get_render_device(), m_shader_layout->get_set_layouts());
+	[[nodiscard]] auto create_shader(SpirV const vertex, SpirV const fragment, InstanceFormat const instance_format) const
+		-> std::unique_ptr<IShader> final {
+		auto ret = std::make_unique<Shader>(&get_render_device(), m_shader_layout->get_set_layouts(), instance_format);
 		if (!ret->load(vertex, fragment)) { return {}; }
 		return ret;
 	}
@@ -448,6 +1054,17 @@ class ResourceFactory : public IResourceFactory {
 		return ret;
 	}
 
+	[[nodiscard]] auto create_font_page(glm::ivec2 const size) const -> std::unique_ptr<IFontPage> final {
+		return std::make_unique<FontPage>(&get_render_device(), m_sampler_factory, size);
+	}
+
+	[[nodiscard]] auto create_geometry_buffer(std::span<Vertex const> vertices, std::span<std::uint32_t const> indices) const
+		-> std::unique_ptr<IGeometryBuffer> final {
+		auto ret = std::make_unique<GeometryBuffer>(&get_render_device(), m_deferred_release);
+		if (!ret->write(vertices, indices)) { return {}; }
+		return ret;
+	}
+
 	[[nodiscard]] auto create_audio_buffer(std::span<std::byte const> bytes, std::optional<capo::Encoding> encoding) const
 		-> std::unique_ptr<IAudioBuffer> final {
 		auto ret = std::make_unique<AudioBuffer>();
@@ -457,17 +1074,53 @@ class ResourceFactory : public IResourceFactory {
 
 	gsl::not_null<ISamplerFactory*> m_sampler_factory;
 	gsl::not_null<ShaderLayout const*> m_shader_layout;
+	gsl::not_null<DeferredRelease*> m_deferred_release;
 };
 
 #pragma endregion
 
 #pragma region RenderResources
 
-[[nodiscard]] auto create_default_shader(gsl::not_null<IResourceFactory const*> resource_factory) -> std::unique_ptr<IShader> {
-	auto const vert_spirv = spirv::vert();
-	auto const frag_spirv = spirv::frag();
-	auto ret = resource_factory->create_shader(vert_spirv, frag_spirv);
-	if (!ret->load(vert_spirv, frag_spirv)) { throw Error{"Failed to create default shader"}; }
+[[nodiscard]] auto create_builtin_shader(gsl::not_null<IResourceFactory const*> resource_factory, IShader::SpirV const vert_spirv,
+										 IShader::SpirV const frag_spirv, std::string_view const name,
+										 InstanceFormat const instance_format = InstanceFormat::Std430) -> std::unique_ptr<IShader> {
+	auto ret = resource_factory->create_shader(vert_spirv, frag_spirv, instance_format);
+	if (!ret || !ret->load(vert_spirv, frag_spirv)) { throw Error{std::format("Failed to create {} shader", name)}; }
+	return ret;
+}
+
+// indexed by InstanceFormat, then by TextureKind.
+using BuiltinShaders = std::array<std::array<std::unique_ptr<IShader>, std::size_t(TextureKind::COUNT_)>, 3>;
+
+[[nodiscard]] auto create_builtin_shaders(gsl::not_null<IResourceFactory const*> resource_factory) -> BuiltinShaders {
+	struct Stage {
+		IShader::SpirV spirv{};
+		std::string_view name{};
+	};
+	// vertex shaders by InstanceFormat, fragment shaders by TextureKind.
+	auto const verts = std::array{Stage{spirv::vert(), "default"}, Stage{spirv::compact_vert(), "compact"}, Stage{spirv::glyph_vert(), "glyph"}};
+	auto const frags = std::array{Stage{spirv::frag(), "color"}, Stage{spirv::sdf_frag(), "sdf"}};
+	static_assert(verts.size() == std::tuple_size_v<BuiltinShaders> && frags.size() == std::size_t(TextureKind::COUNT_));
+
+	auto ret = BuiltinShaders{};
+	for (std::size_t format = 0; format < verts.size(); ++format) {
+		for (std::size_t kind = 0; kind < frags.size(); ++kind) {
+			auto const name = std::format("{} {}", verts[format].name, frags[kind].name);
+			ret[format][kind] = create_builtin_shader(resource_factory, verts[format].spirv, frags[kind].spirv, name, InstanceFormat(format));
+		}
+	}
+	return ret;
+}
+
+[[nodiscard]] auto create_texture_table_shader(gsl::not_null<IResourceFactory const*> resource_factory, ShaderLayout const& shader_layout)
+	-> std::unique_ptr<IShader> {
+	if (!shader_layout.has_texture_tables()) { return {}; }
+	return create_builtin_shader(resource_factory, spirv::texture_table_vert(), spirv::texture_table_frag(), "texture table");
+}
+
+[[nodiscard]] auto create_quad_index_buffer(gsl::not_null<IResourceFactory const*> resource_factory) -> std::unique_ptr<IGeometryBuffer> {
+	auto ret = resource_factory->create_geometry_buffer({}, shape::Quad::list_indices(shape::Quad::max_list_quads_v));
+	if (!ret) { throw Error{"Failed to create quad index buffer"}; }
 	return ret;
 }
 
@@ -475,19 +1128,36 @@ class RenderResources : public IRenderResources {
   public:
 	explicit RenderResources(gsl::not_null<ISamplerFactory*> sampler_factory, gsl::not_null<ShaderLayout const*> shader_layout,
 							 gsl::not_null<IResourceFactory const*> resource_factory)
-		: m_shader_layout(shader_layout), m_default_shader(create_default_shader(resource_factory)),
-		  m_white_texture(&resource_factory->get_render_device(), sampler_factory), m_waiter(resource_factory->get_render_device().get_device()) {}
+		: m_shader_layout(shader_layout), m_builtin_shaders(create_builtin_shaders(resource_factory)),
+		  m_texture_table_shader(create_texture_table_shader(resource_factory, *shader_layout)),
+		  m_quad_index_buffer(create_quad_index_buffer(resource_factory)), m_white_texture(&resource_factory->get_render_device(), sampler_factory), m_waiter(resource_factory->get_render_device().get_device()) {}
 
 	[[nodiscard]] auto get_shader_layout() const -> ShaderLayout const& final { return *m_shader_layout; }
-	[[nodiscard]] auto get_default_shader() const -> IShader const& final { return *m_default_shader; }
+	[[nodiscard]] auto get_default_shader() const -> IShader const& final { return get_builtin_shader(InstanceFormat::Std430, TextureKind::Color); }
+	[[nodiscard]] auto get_builtin_shader(InstanceFormat const format, TextureKind const kind) const -> IShader const& final {
+		return *m_builtin_shaders.at(std::size_t(format)).at(std::size_t(kind));
+	}
+
+	[[nodiscard]] auto is_builtin(IShader const& shader) const -> bool final {
+		if (&shader == m_texture_table_shader.get()) { return true; }
+		return std::ranges::any_of(m_builtin_shaders, [&shader](auto const& shaders) {
+			return std::ranges::any_of(shaders, [&shader](std::unique_ptr<IShader> const& builtin) { return builtin.get() == &shader; });
+		});
+	}
+
+	[[nodiscard]] auto get_texture_table_shader() const -> IShader const* final { return m_texture_table_shader.get(); }
+
 	[[nodiscard]] auto get_white_texture() const -> ITexture const& final { return m_white_texture; }
+	[[nodiscard]] auto get_quad_index_buffer() const -> IGeometryBuffer const& final { return *m_quad_index_buffer; }
 
 	std::vector<RenderInstance::Std430> render_instance_buffer{};
 
   private:
 	gsl::not_null<ShaderLayout const*> m_shader_layout;
 
-	std::unique_ptr<IShader> m_default_shader{};
+	BuiltinShaders m_builtin_shaders{};
+	std::unique_ptr<IShader> m_texture_table_shader{};
+	std::unique_ptr<IGeometryBuffer> m_quad_index_buffer{};
 
 	Texture m_white_texture;
 
@@ -572,12 +1242,19 @@ class RenderPass : public IRenderPass {
 };
 
 #pragma endregion
+
+// the render device does not enable (nor report) Vulkan 1.2 descriptor indexing features, so texture tables stay disabled until it does.
+[[nodiscard]] auto supports_texture_tables(kvf::IRenderDevice const& render_device) -> bool {
+	auto const enabled_features = vk::PhysicalDeviceVulkan12Features{};
+	return ShaderLayout::supports_texture_tables(enabled_features, render_device.get_gpu().properties.limits);
+}
 } // namespace
 
 ContextResources::ContextResources(gsl::not_null<kvf::IRenderDevice*> render_device, int const sfx_sources)
-	: audio_mixer(std::make_unique<AudioMixer>(sfx_sources)), shader_layout(std::make_unique<ShaderLayout>(render_device->get_device())),
-	  sampler_factory(std::make_unique<SamplerFactory>(render_device)),
-	  resource_factory(std::make_unique<ResourceFactory>(sampler_factory.get(), shader_layout.get())),
+	: audio_mixer(std::make_unique<AudioMixer>(sfx_sources)),
+	  shader_layout(std::make_unique<ShaderLayout>(render_device->get_device(), supports_texture_tables(*render_device))),
+	  sampler_factory(std::make_unique<SamplerFactory>(render_device)), deferred_release(std::make_unique<DeferredRelease>()),
+	  resource_factory(std::make_unique<ResourceFactory>(sampler_factory.get(), shader_layout.get(), deferred_release.get())),
 	  render_resources(std::make_unique<RenderResources>(sampler_factory.get(), shader_layout.get(), resource_factory.get())) {}
 
 auto ContextResources::create_render_pass(vk::SampleCountFlagBits samples) const -> std::unique_ptr<IRenderPass> {
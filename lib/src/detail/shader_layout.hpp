@@ -1,31 +1,58 @@
 #pragma once
 #include <vulkan/vulkan.hpp>
 #include <array>
+#include <cstdint>
 #include <ranges>
 
 namespace le::detail {
 class ShaderLayout {
   public:
+	// sets bound by every draw.
 	static constexpr auto set_count_v{3uz};
+	// set of a batch's texture table, only read by the texture table shaders (lib/glsl/texture_table.*).
+	static constexpr auto texture_table_set_v{set_count_v};
+	// textures in a table, fixed by the texture table shaders.
+	static constexpr std::uint32_t texture_table_size_v{16};
 
-	explicit ShaderLayout(vk::Device const device) {
+	// texture tables index sampler arrays non-uniformly, which is only valid if the device was created with that feature enabled
+	// (the physical device reporting it is not enough), and need room for a table alongside the textures of sets 1 and 2.
+	[[nodiscard]] static auto supports_texture_tables(vk::PhysicalDeviceVulkan12Features const& enabled_features, vk::PhysicalDeviceLimits const& limits)
+		-> bool {
+		if (!enabled_features.shaderSampledImageArrayNonUniformIndexing) { return false; }
+		auto const samplers = texture_table_size_v + 2;
+		return limits.maxPerStageDescriptorSamplers >= samplers && limits.maxPerStageDescriptorSampledImages >= samplers;
+	}
+
+	// the texture table set is only part of the layout if texture_tables is set.
+	explicit ShaderLayout(vk::Device const device, bool const texture_tables = false) : m_set_layout_count(texture_tables ? set_count_v + 1 : set_count_v) {
 		create_set_layouts(device);
 		create_pipeline_layout(device);
 	}
 
 	[[nodiscard]] auto get_pipeline_layout() const -> vk::PipelineLayout { return *m_pipeline_layout; }
-	[[nodiscard]] auto get_set_layouts() const -> std::span<vk::DescriptorSetLayout const, set_count_v> { return m_set_layouts; }
+	[[nodiscard]] auto get_set_layouts() const -> std::span<vk::DescriptorSetLayout const> { return std::span{m_set_layouts}.first(m_set_layout_count); }
+	[[nodiscard]] auto has_texture_tables() const -> bool { return m_set_layout_count > texture_table_set_v; }
 
   private:
 	void create_set_layouts(vk::Device const device) {
 		static constexpr auto set_0_bindings_v = std::array{
 			vk::DescriptorSetLayoutBinding{0, vk::DescriptorType::eUniformBuffer, 1, vk::ShaderStageFlagBits::eAllGraphics},
 		};
-		static constexpr auto set_1_bindings_v = std::array{
+		static constexpr auto set_2_bindings = std::array{
 			vk::DescriptorSetLayoutBinding{0, vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eAllGraphics},
 			vk::DescriptorSetLayoutBinding{1, vk::DescriptorType::eCombinedImageSampler, 1, vk::ShaderStageFlagBits::eAllGraphics},
 		};
-		static constexpr auto set_2_bindings = set_1_bindings_v;
+		// binding 2 is the Std430 instance stream, read by glyph shaders (whose binding 0 holds glyphs).
+		static constexpr auto set_1_bindings_v = std::array{
+			set_2_bindings[0],
+			set_2_bindings[1],
+			vk::DescriptorSetLayoutBinding{2, vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eVertex},
+		};
+		// per vertex texture indices of a batch, and the textures they index.
+		static constexpr auto texture_table_bindings_v = std::array{
+			vk::DescriptorSetLayoutBinding{0, vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eVertex},
+			vk::DescriptorSetLayoutBinding{1, vk::DescriptorType::eCombinedImageSampler, texture_table_size_v, vk::ShaderStageFlagBits::eFragment},
+		};
 
 		auto dslci = vk::DescriptorSetLayoutCreateInfo{};
 		dslci.setBindings(set_0_bindings_v);
@@ -37,17 +64,23 @@ class ShaderLayout {
 		dslci.setBindings(set_2_bindings);
 		m_set_layout_storage[2] = device.createDescriptorSetLayoutUnique(dslci);
 
+		if (has_texture_tables()) {
+			dslci.setBindings(texture_table_bindings_v);
+			m_set_layout_storage[texture_table_set_v] = device.createDescriptorSetLayoutUnique(dslci);
+		}
+
 		for (auto [in, out] : std::ranges::zip_view(m_set_layout_storage, m_set_layouts)) { out = *in; }
 	}
 
 	void create_pipeline_layout(vk::Device const device) {
 		auto plci = vk::PipelineLayoutCreateInfo{};
-		plci.setSetLayouts(m_set_layouts);
+		plci.setSetLayouts(get_set_layouts());
 		m_pipeline_layout = device.createPipelineLayoutUnique(plci);
 	}
 
-	std::array<vk::UniqueDescriptorSetLayout, set_count_v> m_set_layout_storage{};
-	std::array<vk::DescriptorSetLayout, set_count_v> m_set_layouts{};
+	std::size_t m_set_layout_count;
+	std::array<vk::UniqueDescriptorSetLayout, set_count_v + 1> m_set_layout_storage{};
+	std::array<vk::DescriptorSetLayout, set_count_v + 1> m_set_layouts{};
 	vk::UniquePipelineLayout m_pipeline_layout{};
 };
 } // namespace le::detail
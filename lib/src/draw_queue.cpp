@@ -0,0 +1,94 @@
+#include "le2d/draw_queue.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <limits>
+#include <utility>
+
+namespace le {
+namespace {
+// key layout (most significant first): layer [16] | shader [8] | texture [16] | depth [24].
+constexpr auto shader_bits_v = 8;
+constexpr auto texture_bits_v = 16;
+constexpr auto depth_bits_v = 24;
+
+constexpr auto max_id(int const bits) -> std::uint32_t { return (std::uint32_t{1} << bits) - 1; }
+
+// maps a float to an unsigned integer with the same ordering.
+constexpr auto to_sortable(float const depth) -> std::uint32_t {
+	auto const bits = std::bit_cast<std::uint32_t>(depth);
+	return (bits & 0x80000000u) == 0 ? bits | 0x80000000u : ~bits;
+}
+
+constexpr auto make_key(std::int16_t const layer, std::uint32_t const shader, std::uint32_t const texture, float const depth) -> std::uint64_t {
+	auto const biased_layer = std::uint64_t(std::uint16_t(std::int32_t(layer) - std::numeric_limits<std::int16_t>::min()));
+	auto ret = biased_layer;
+	ret = (ret << shader_bits_v) | std::min(shader, max_id(shader_bits_v));
+	ret = (ret << texture_bits_v) | std::min(texture, max_id(texture_bits_v));
+	ret = (ret << depth_bits_v) | (to_sortable(depth) >> (32 - depth_bits_v));
+	return ret;
+}
+
+// returns a dense ID for ptr, assigned in order of first appearance.
+auto get_id(std::unordered_map<void const*, std::uint32_t>& out, void const* ptr) -> std::uint32_t {
+	auto const [it, _] = out.emplace(ptr, std::uint32_t(out.size()));
+	return it->second;
+}
+} // namespace
+
+void DrawQueue::submit(Primitive const& primitive, std::span<RenderInstance const> instances, DrawKey const& key) {
+	if (auto const draw = m_store.push(primitive, instances)) { m_entries.push_back(Entry{.draw = *draw, .key = key}); }
+}
+
+void DrawQueue::submit_baked(Primitive const& primitive, std::span<RenderInstance::Std430 const> instances, DrawKey const& key) {
+	if (auto const draw = m_store.push_baked(primitive, instances)) { m_entries.push_back(Entry{.draw = *draw, .key = key}); }
+}
+
+void DrawQueue::flush(IRenderer& renderer) {
+	if (m_entries.empty()) { return; }
+
+	auto const& original_shader = renderer.get_shader();
+	sort(original_shader);
+
+	for (auto const& sortable : m_sorted) {
+		auto const& entry = m_entries[sortable.index];
+		renderer.set_shader(entry.key.shader == nullptr ? original_shader : *entry.key.shader);
+		m_store.draw(renderer, entry.draw);
+	}
+	renderer.set_shader(original_shader);
+
+	clear();
+}
+
+void DrawQueue::clear() {
+	m_entries.clear();
+	m_store.clear();
+}
+
+void DrawQueue::sort(IShader const& fallback) {
+	m_shader_ids.clear();
+	m_texture_ids.clear();
+	m_sorted.clear();
+	m_sorted.reserve(m_entries.size());
+	for (std::uint32_t i = 0; i < std::uint32_t(m_entries.size()); ++i) {
+		auto const& entry = m_entries[i];
+		auto const* shader = entry.key.shader == nullptr ? &fallback : &*entry.key.shader;
+		auto const shader_id = get_id(m_shader_ids, shader);
+		auto const texture_id = get_id(m_texture_ids, entry.draw.texture);
+		m_sorted.push_back(Sortable{.key = make_key(entry.key.layer, shader_id, texture_id, entry.key.depth), .index = i});
+	}
+
+	// stable LSD radix sort, 8 bits per pass; passes where every key shares the same digit are skipped.
+	m_scratch.resize(m_sorted.size());
+	for (int shift = 0; shift < 64; shift += 8) {
+		auto counts = std::array<std::uint32_t, 256>{};
+		for (auto const& sortable : m_sorted) { ++counts[(sortable.key >> shift) & 0xff]; }
+		if (counts[(m_sorted.front().key >> shift) & 0xff] == m_sorted.size()) { continue; }
+
+		auto offset = std::uint32_t{};
+		for (auto& count : counts) { offset += std::exchange(count, offset); }
+		for (auto const& sortable : m_sorted) { m_scratch[counts[(sortable.key >> shift) & 0xff]++] = sortable; }
+		std::swap(m_sorted, m_scratch);
+	}
+}
+} // namespace le
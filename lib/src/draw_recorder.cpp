@@ -0,0 +1,43 @@
+#include "le2d/draw_recorder.hpp"
+#include "klib/visitor.hpp"
+
+namespace le {
+void DrawRecorder::set_view(Transform const& view) { m_commands.emplace_back(view); }
+
+void DrawRecorder::set_shader(IShader const& shader) { m_commands.emplace_back(&shader); }
+
+void DrawRecorder::set_scissor_rect(kvf::UvRect const& rect) { m_commands.emplace_back(rect); }
+
+void DrawRecorder::draw(Primitive const& primitive, std::span<RenderInstance const> instances) {
+	if (auto const draw = m_store.push(primitive, instances)) { m_commands.emplace_back(*draw); }
+}
+
+void DrawRecorder::draw_baked(Primitive const& primitive, std::span<RenderInstance::Std430 const> instances) {
+	if (auto const draw = m_store.push_baked(primitive, instances)) { m_commands.emplace_back(*draw); }
+}
+
+void DrawRecorder::replay(IRenderer& renderer) const {
+	if (m_commands.empty()) { return; }
+
+	auto const original_view = renderer.get_view();
+	auto const& original_shader = renderer.get_shader();
+	auto const original_scissor = renderer.scissor_rect;
+
+	auto const visitor = klib::Visitor{
+		[&](PrimitiveStore::Entry const& draw) { m_store.draw(renderer, draw); },
+		[&](Transform const& view) { renderer.set_view(view); },
+		[&](IShader const* shader) { renderer.set_shader(*shader); },
+		[&](kvf::UvRect const& rect) { renderer.scissor_rect = rect; },
+	};
+	for (auto const& command : m_commands) { std::visit(visitor, command); }
+
+	renderer.set_view(original_view);
+	renderer.set_shader(original_shader);
+	renderer.scissor_rect = original_scissor;
+}
+
+void DrawRecorder::clear() {
+	m_commands.clear();
+	m_store.clear();
+}
+} // namespace le
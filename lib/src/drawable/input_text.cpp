@@ -127,9 +127,7 @@ void InputText::draw(IRenderer& renderer) const {
 	if (!is_interactive()) { return; }
 
 	auto const cursor_primitive = Primitive{
-		.vertices = m_cursor.get_vertices(),
-		.indices = m_cursor.get_indices(),
-		.topology = m_cursor.get_topology(),
+		.glyphs = m_cursor.get_glyphs(),
 		.texture = line_primitive.texture,
 	};
 	auto cursor_instance = RenderInstance{
@@ -1,28 +1,65 @@
 #include "le2d/drawable/text.hpp"
+#include <algorithm>
 
 namespace le::drawable {
+namespace {
+auto get_atlas(IFont& font, TextParams const& params) -> ScaledAtlas {
+	auto const height = float(params.height) * params.scale;
+	if (params.distance_field) { return font.get_scaled_atlas(height); }
+	auto const clamped = std::clamp(height, float(TextHeight::Min), float(TextHeight::Max));
+	return ScaledAtlas{.atlas = &font.get_atlas(TextHeight(clamped)), .scale = 1.0f};
+}
+
+// whether a and b produce the same geometry for the same atlas and string.
+auto is_same_layout(TextParams const& a, TextParams const& b) -> bool {
+	return a.height == b.height && a.expand == b.expand && a.scale == b.scale && a.distance_field == b.distance_field;
+}
+} // namespace
+
 void TextBase::set_string(IFont& font, std::string_view const line, Params const& params) {
-	m_geometry.clear_vertices();
-	m_glyph_layouts.clear();
-	m_size = {};
+	if (line.empty()) {
+		m_geometry.clear_vertices();
+		m_glyph_layouts.clear();
+		m_size = {};
+		m_atlas_key.reset();
+		m_line.clear();
+		return;
+	}
 
-	if (line.empty()) { return; }
+	auto const [font_atlas, scale] = get_atlas(font, params);
+	IFontAtlas const* atlas = font_atlas;
+	auto const atlas_key = AtlasKey{.generation = atlas->get_generation(), .height = atlas->get_height()};
+	if (atlas_key == m_atlas_key && line == m_line && is_same_layout(params, m_params)) { return; }
 
-	auto const& font_atlas = font.get_atlas(params.height);
-	m_texture = &font_atlas.get_texture();
+	m_atlas_key = atlas_key;
+	m_line = line;
+	m_params = params;
 
-	font_atlas.push_layouts(m_glyph_layouts, line);
+	m_geometry.clear_vertices();
 
-	auto const rect = kvf::ttf::glyph_bounds(m_glyph_layouts);
-	m_size = rect.size();
+	m_glyph_layouts.clear();
+	auto glyph_layouts = std::span<kvf::ttf::GlyphLayout const>{};
+	auto rect = kvf::Rect<>{};
+	if (params.layout_cache) {
+		auto const& layout = params.layout_cache->get_layout(*atlas, line);
+		glyph_layouts = layout.glyphs;
+		rect = layout.bounds;
+	} else {
+		font_atlas->push_layouts(m_glyph_layouts, line);
+		glyph_layouts = m_glyph_layouts;
+		rect = kvf::ttf::glyph_bounds(m_glyph_layouts);
+	}
+	m_size = rect.size() * scale;
+	// after laying out: uploads glyphs rasterized for this string.
+	m_texture = &font_atlas->get_texture();
 
 	auto offset = glm::vec2{};
 	switch (params.expand) {
-	case TextExpand::eBoth: offset.x -= (0.5f * m_size.x) + rect.lt.x; break;
-	case TextExpand::eLeft: offset.x -= m_size.x + rect.lt.x; break;
+	case TextExpand::eBoth: offset.x -= (0.5f * m_size.x) + (rect.lt.x * scale); break;
+	case TextExpand::eLeft: offset.x -= m_size.x + (rect.lt.x * scale); break;
 	default: break;
 	}
 
-	m_geometry.append_glyphs(m_glyph_layouts, offset);
+	m_geometry.append_glyphs(glyph_layouts, offset, kvf::white_v, scale);
 }
 } // namespace le::drawable
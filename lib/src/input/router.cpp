@@ -1,4 +1,5 @@
 #include "le2d/input/router.hpp"
+#include "le2d/profile.hpp"
 #include <imgui.h>
 #include <ranges>
 
@@ -35,6 +36,7 @@ auto Router::contains_mapping(std::shared_ptr<IMapping> const& mapping) const ->
 }
 
 void Router::dispatch(std::span<Event const> events) {
+	LE_PROFILE_ZONE("Router::dispatch");
 	auto should_disengage = false;
 	for (auto const& event : events) {
 		if (std::holds_alternative<event::Key>(event)) {
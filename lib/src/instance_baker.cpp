@@ -0,0 +1,178 @@
+#include "le2d/instance_baker.hpp"
+#include "klib/debug/assert.hpp"
+#include "klib/task/queue.hpp"
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace le {
+namespace {
+// sRGB -> linear conversion for every u8 channel value, matching kvf::Color::to_linear().
+struct LinearLut {
+	LinearLut() {
+		for (std::size_t i = 0; i < rgb.size(); ++i) {
+			auto color = kvf::Color{};
+			color.x = color.y = color.z = color.w = std::uint8_t(i);
+			auto const linear = color.to_linear();
+			rgb[i] = linear.x;
+			alpha[i] = linear.w;
+		}
+	}
+
+	[[nodiscard]] auto to_linear(kvf::Color const color) const -> glm::vec4 { return {rgb[color.x], rgb[color.y], rgb[color.z], alpha[color.w]}; }
+
+	std::array<float, 256> rgb{};
+	std::array<float, 256> alpha{};
+};
+
+auto get_lut() -> LinearLut const& {
+	static auto const ret = LinearLut{};
+	return ret;
+}
+
+// equivalent to translate * rotate * scale, with the rotation taken directly from the (normalized) orientation.
+constexpr auto to_model(glm::vec2 const position, glm::vec2 const orientation, glm::vec2 const scale) -> glm::mat4 {
+	auto ret = glm::mat4{1.0f};
+	ret[0] = glm::vec4{scale.x * orientation.x, scale.x * orientation.y, 0.0f, 0.0f};
+	ret[1] = glm::vec4{-scale.y * orientation.y, scale.y * orientation.x, 0.0f, 0.0f};
+	ret[3] = glm::vec4{position, 0.0f, 1.0f};
+	return ret;
+}
+
+auto to_tint(kvf::Color const color, bool const linearize) -> glm::vec4 { return linearize ? get_lut().to_linear(color) : color.to_vec4(); }
+
+template <typename Type>
+auto at_or(std::span<Type const> values, std::size_t const index, Type const fallback) -> Type {
+	return values.empty() ? fallback : values[index];
+}
+
+class BakeTask : public klib::task::Task {
+  public:
+	std::span<RenderInstance::Std430> out{};
+	std::span<RenderInstance const> instances{};
+	RenderInstanceStreams streams{};
+	bool linearize_tint{};
+
+  private:
+	void execute() final {
+		if (streams.positions.empty()) {
+			bake_instances(out, instances, linearize_tint);
+		} else {
+			bake_instances(out, streams, linearize_tint);
+		}
+	}
+};
+
+class InstanceBaker : public IInstanceBaker {
+  public:
+	InstanceBaker(InstanceBaker const&) = delete;
+	InstanceBaker(InstanceBaker&&) = delete;
+	InstanceBaker& operator=(InstanceBaker const&) = delete;
+	InstanceBaker& operator=(InstanceBaker&&) = delete;
+
+	explicit InstanceBaker(CreateInfo const& create_info)
+		: m_min_parallel_count(std::max(create_info.min_parallel_count, std::size_t{1})),
+		  m_max_chunks(std::size_t(std::max(int(create_info.thread_count), 1))),
+		  m_queue(klib::task::Queue::CreateInfo{.thread_count = create_info.thread_count}) {}
+
+	~InstanceBaker() { m_queue.drain_and_wait(); }
+
+  private:
+	void bake(std::span<RenderInstance::Std430> out, std::span<RenderInstance const> in, bool const linearize_tint) final {
+		if (in.size() < m_min_parallel_count) {
+			bake_instances(out, in, linearize_tint);
+			return;
+		}
+		dispatch(in.size(), [&](BakeTask& task, std::size_t const offset, std::size_t const count) {
+			task.out = out.subspan(offset, count);
+			task.instances = in.subspan(offset, count);
+			task.streams = {};
+			task.linearize_tint = linearize_tint;
+		});
+	}
+
+	void bake(std::span<RenderInstance::Std430> out, RenderInstanceStreams const& in, bool const linearize_tint) final {
+		if (in.get_size() < m_min_parallel_count) {
+			bake_instances(out, in, linearize_tint);
+			return;
+		}
+		auto const sub = [](auto const span, std::size_t const offset, std::size_t const count) { return span.empty() ? span : span.subspan(offset, count); };
+		dispatch(in.get_size(), [&](BakeTask& task, std::size_t const offset, std::size_t const count) {
+			task.out = out.subspan(offset, count);
+			task.instances = {};
+			task.streams = RenderInstanceStreams{
+				.positions = in.positions.subspan(offset, count),
+				.orientations = sub(in.orientations, offset, count),
+				.scales = sub(in.scales, offset, count),
+				.tints = sub(in.tints, offset, count),
+			};
+			task.linearize_tint = linearize_tint;
+		});
+	}
+
+	template <typename F>
+	void dispatch(std::size_t const total, F setup) {
+		// build the LUT before any worker needs it.
+		[[maybe_unused]] auto const& lut = get_lut();
+
+		auto const chunks = std::min(total / m_min_parallel_count, m_max_chunks);
+		auto const chunk_size = (total + chunks - 1) / chunks;
+		while (m_tasks.size() < chunks) { m_tasks.push_back(std::make_unique<BakeTask>()); }
+		m_enqueued.clear();
+		for (std::size_t i = 0, offset = 0; i < chunks && offset < total; ++i, offset += chunk_size) {
+			auto& task = *m_tasks[i];
+			setup(task, offset, std::min(chunk_size, total - offset));
+			m_enqueued.push_back(&task);
+		}
+		m_queue.enqueue(m_enqueued);
+		m_queue.drain_and_wait();
+	}
+
+	std::size_t m_min_parallel_count;
+	std::size_t m_max_chunks;
+	klib::task::Queue m_queue;
+
+	std::vector<std::unique_ptr<BakeTask>> m_tasks{};
+	std::vector<klib::task::Task*> m_enqueued{};
+};
+} // namespace
+
+void bake_instances(std::span<RenderInstance::Std430> out, std::span<RenderInstance const> in, bool const linearize_tint) {
+	KLIB_ASSERT(out.size() >= in.size());
+	for (std::size_t i = 0; i < in.size(); ++i) {
+		auto const& instance = in[i];
+		out[i].transform = to_model(instance.transform.position, instance.transform.orientation, instance.transform.scale);
+		out[i].tint = to_tint(instance.tint, linearize_tint);
+	}
+}
+
+void bake_instances(std::span<RenderInstance::Std430> out, RenderInstanceStreams const& in, bool const linearize_tint) {
+	auto const size = in.get_size();
+	KLIB_ASSERT(out.size() >= size);
+	KLIB_ASSERT(in.orientations.empty() || in.orientations.size() == size);
+	KLIB_ASSERT(in.scales.empty() || in.scales.size() == size);
+	KLIB_ASSERT(in.tints.empty() || in.tints.size() == size);
+	for (std::size_t i = 0; i < size; ++i) {
+		auto const orientation = at_or(in.orientations, i, right_v);
+		auto const scale = at_or(in.scales, i, glm::vec2{1.0f});
+		out[i].transform = to_model(in.positions[i], orientation, scale);
+		out[i].tint = to_tint(at_or(in.tints, i, kvf::white_v), linearize_tint);
+	}
+}
+
+void bake_instances(std::span<RenderInstance::Std430> out, std::span<RenderInstance::Compact const> in) {
+	KLIB_ASSERT(out.size() >= in.size());
+	auto const& lut = get_lut();
+	for (std::size_t i = 0; i < in.size(); ++i) {
+		auto const& instance = in[i];
+		auto& transform = out[i].transform;
+		transform = glm::mat4{1.0f};
+		transform[0] = glm::vec4{instance.linear.x, instance.linear.y, 0.0f, 0.0f};
+		transform[1] = glm::vec4{instance.linear.z, instance.linear.w, 0.0f, 0.0f};
+		transform[3] = glm::vec4{instance.translation, 0.0f, 1.0f};
+		out[i].tint = lut.to_linear(instance.tint);
+	}
+}
+
+auto IInstanceBaker::create(CreateInfo const& create_info) -> std::unique_ptr<IInstanceBaker> { return std::make_unique<InstanceBaker>(create_info); }
+} // namespace le
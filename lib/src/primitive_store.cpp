@@ -0,0 +1,74 @@
+#include "le2d/primitive_store.hpp"
+#include "le2d/instance_baker.hpp"
+#include "le2d/shape/quad.hpp"
+#include <utility>
+
+namespace le {
+namespace {
+auto has_geometry(Primitive const& primitive) -> bool {
+	return primitive.get_vertex_count() > 0 || !primitive.glyphs.empty() || primitive.geometry_buffer != nullptr;
+}
+
+template <typename Type>
+auto append(std::vector<Type>& out, std::span<Type const> in) {
+	auto const offset = std::uint32_t(out.size());
+	out.insert(out.end(), in.begin(), in.end());
+	return PrimitiveStore::Range{.offset = offset, .count = std::uint32_t(in.size())};
+}
+} // namespace
+
+auto PrimitiveStore::push(Primitive const& primitive, std::span<RenderInstance const> instances) -> std::optional<Entry> {
+	if (!has_geometry(primitive) || instances.empty()) { return {}; }
+	auto const offset = std::uint32_t(m_instances.size());
+	m_instances.resize(m_instances.size() + instances.size());
+	bake_instances(std::span{m_instances}.subspan(offset), instances);
+	return store(primitive, Range{.offset = offset, .count = std::uint32_t(instances.size())});
+}
+
+auto PrimitiveStore::push_baked(Primitive const& primitive, std::span<RenderInstance::Std430 const> instances) -> std::optional<Entry> {
+	if (!has_geometry(primitive) || instances.empty()) { return {}; }
+	return store(primitive, append(m_instances, instances));
+}
+
+void PrimitiveStore::draw(IRenderer& renderer, Entry const& entry) const {
+	auto const vertices = std::span<Vertex const>{m_vertices};
+	auto const packed_vertices = std::span<PackedVertex const>{m_packed_vertices};
+	auto const indices = std::span<std::uint32_t const>{m_indices};
+	auto const primitive = Primitive{
+		.vertices = entry.packed ? std::span<Vertex const>{} : vertices.subspan(entry.vertices.offset, entry.vertices.count),
+		.packed_vertices = entry.packed ? packed_vertices.subspan(entry.vertices.offset, entry.vertices.count) : std::span<PackedVertex const>{},
+		.indices = entry.quad_list ? shape::Quad::list_indices(entry.indices.count / shape::Quad::indices_v.size())
+								   : indices.subspan(entry.indices.offset, entry.indices.count),
+		.glyphs = std::span{m_glyphs}.subspan(entry.glyphs.offset, entry.glyphs.count),
+		.topology = entry.topology,
+		.texture = entry.texture,
+		.geometry_buffer = entry.geometry_buffer,
+	};
+	renderer.draw_baked(primitive, std::span{m_instances}.subspan(entry.instances.offset, entry.instances.count));
+}
+
+void PrimitiveStore::clear() {
+	m_vertices.clear();
+	m_packed_vertices.clear();
+	m_indices.clear();
+	m_glyphs.clear();
+	m_instances.clear();
+}
+
+auto PrimitiveStore::store(Primitive const& primitive, Range const instances) -> Entry {
+	auto const quad_list = !primitive.indices.empty() && primitive.indices.data() == shape::Quad::list_indices(1).data();
+	// only the format that will be uploaded is copied.
+	auto const packed = primitive.get_vertex_format() == VertexFormat::Packed;
+	return Entry{
+		.vertices = packed ? append(m_packed_vertices, primitive.packed_vertices) : append(m_vertices, primitive.vertices),
+		.indices = quad_list ? Range{.offset = 0, .count = std::uint32_t(primitive.indices.size())} : append(m_indices, primitive.indices),
+		.glyphs = append(m_glyphs, primitive.glyphs),
+		.instances = instances,
+		.topology = primitive.topology,
+		.texture = primitive.texture,
+		.geometry_buffer = primitive.geometry_buffer,
+		.quad_list = quad_list,
+		.packed = packed,
+	};
+}
+} // namespace le
@@ -0,0 +1,120 @@
+#include "le2d/profile.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <format>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace le {
+namespace {
+struct Record {
+	char const* name{};
+	profile::Clock::time_point start{};
+	profile::Clock::duration duration{};
+};
+
+// written by its owning thread, read by to_chrome_trace(): the mutex is uncontended outside of export.
+struct ThreadLog {
+	[[nodiscard]] auto get_size() const -> std::size_t { return std::min(count, records.size()); }
+
+	void push(Record const& record) {
+		auto lock = std::scoped_lock{mutex};
+		records[count++ % records.size()] = record;
+	}
+
+	std::mutex mutex{};
+	std::array<Record, profile::ring_capacity_v> records{};
+	std::size_t count{};
+	std::uint32_t thread_id{};
+};
+
+struct Registry {
+	auto add_thread() -> ThreadLog* {
+		auto lock = std::scoped_lock{mutex};
+		auto log = std::make_shared<ThreadLog>();
+		log->thread_id = std::uint32_t(logs.size());
+		return logs.emplace_back(std::move(log)).get();
+	}
+
+	std::mutex mutex{};
+	// logs outlive their threads so that zones can be exported afterwards.
+	std::vector<std::shared_ptr<ThreadLog>> logs{};
+	profile::Clock::time_point epoch{profile::Clock::now()};
+	std::atomic<bool> enabled{};
+};
+
+auto get_registry() -> Registry& {
+	static auto ret = Registry{};
+	return ret;
+}
+
+auto get_thread_log() -> ThreadLog& {
+	thread_local auto* ret = get_registry().add_thread();
+	return *ret;
+}
+
+auto to_us(profile::Clock::duration const duration) -> double { return std::chrono::duration<double, std::micro>{duration}.count(); }
+
+void append_escaped(std::string& out, std::string_view const name) {
+	for (auto const c : name) {
+		if (c == '"' || c == '\\') { out += '\\'; }
+		out += c;
+	}
+}
+} // namespace
+
+void profile::set_enabled(bool const enabled) { get_registry().enabled = enabled; }
+
+auto profile::is_enabled() -> bool { return get_registry().enabled; }
+
+profile::Zone::Zone(char const* name) : m_name(name) {
+	if (!is_enabled()) {
+		m_name = nullptr;
+		return;
+	}
+	m_start = Clock::now();
+}
+
+profile::Zone::~Zone() {
+	if (m_name == nullptr) { return; }
+	auto const end = Clock::now();
+	get_thread_log().push(Record{.name = m_name, .start = m_start, .duration = end - m_start});
+}
+
+auto profile::to_chrome_trace() -> std::string {
+	auto& registry = get_registry();
+	auto lock = std::scoped_lock{registry.mutex};
+
+	auto ret = std::string{R"({"traceEvents":[)"};
+	auto first = true;
+	for (auto const& log : registry.logs) {
+		auto log_lock = std::scoped_lock{log->mutex};
+		auto const size = log->get_size();
+		auto const begin = log->count - size;
+		for (auto i = begin; i < log->count; ++i) {
+			auto const& record = log->records[i % log->records.size()];
+			if (!std::exchange(first, false)) { ret += ','; }
+			ret += R"({"name":")";
+			append_escaped(ret, record.name);
+			std::format_to(std::back_inserter(ret), R"(","ph":"X","pid":1,"tid":{},"ts":{:.3f},"dur":{:.3f}}})", log->thread_id,
+						   to_us(record.start - registry.epoch), to_us(record.duration));
+		}
+	}
+	ret += "]}";
+	return ret;
+}
+
+void profile::clear() {
+	auto& registry = get_registry();
+	auto lock = std::scoped_lock{registry.mutex};
+	for (auto const& log : registry.logs) {
+		auto log_lock = std::scoped_lock{log->mutex};
+		log->count = 0;
+	}
+}
+} // namespace le
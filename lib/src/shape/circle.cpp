@@ -5,6 +5,7 @@ void Circle::create(float const diameter, Params const& params) {
 	auto const sector_params = Sector::Params{
 		.color = params.color,
 		.resolution = params.resolution,
+		.vertex_format = params.vertex_format,
 	};
 	m_sector.create(diameter, sector_params);
 }
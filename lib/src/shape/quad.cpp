@@ -1,5 +1,7 @@
 #include "le2d/shape/quad.hpp"
 #include "kvf/is_positive.hpp"
+#include <algorithm>
+#include <vector>
 
 namespace le::shape {
 namespace {
@@ -7,9 +9,41 @@ constexpr std::size_t lb_v{0};
 constexpr std::size_t rb_v{1};
 constexpr std::size_t rt_v{2};
 constexpr std::size_t lt_v{3};
+
+auto build_list_indices() -> std::vector<std::uint32_t> {
+	auto ret = std::vector<std::uint32_t>{};
+	ret.reserve(Quad::max_list_quads_v * Quad::indices_v.size());
+	for (std::uint32_t quad = 0; quad < std::uint32_t(Quad::max_list_quads_v); ++quad) {
+		auto const base = quad * std::uint32_t(IQuad::vertex_count_v);
+		for (auto const index : Quad::indices_v) { ret.push_back(base + index); }
+	}
+	return ret;
+}
 } // namespace
 
-auto IQuad::get_rect() const -> kvf::Rect<> { return kvf::Rect<>{.lt = m_vertices[lt_v].position, .rb = m_vertices[rb_v].position}; }
+auto IQuad::get_vertices() const -> std::span<Vertex const> {
+	if (auto const* ret = std::get_if<Vertices>(&m_vertices)) { return *ret; }
+	return {};
+}
+
+auto IQuad::get_packed_vertices() const -> std::span<PackedVertex const> {
+	if (auto const* ret = std::get_if<PackedVertices>(&m_vertices)) { return *ret; }
+	return {};
+}
+
+auto IQuad::get_vertex_format() const -> VertexFormat {
+	return std::holds_alternative<PackedVertices>(m_vertices) ? VertexFormat::Packed : VertexFormat::Standard;
+}
+
+void IQuad::set_vertex_format(VertexFormat const format) {
+	if (format == m_requested_format) { return; }
+	m_requested_format = format;
+	auto vertices = Vertices{};
+	for (std::size_t i = 0; i < vertices.size(); ++i) { vertices[i] = get_vertex(i); }
+	store(vertices);
+}
+
+auto IQuad::get_rect() const -> kvf::Rect<> { return kvf::Rect<>{.lt = get_vertex(lt_v).position, .rb = get_vertex(rb_v).position}; }
 
 void IQuad::create(glm::vec2 size) {
 	if (!kvf::is_positive(size)) { size = {}; }
@@ -18,11 +52,34 @@ void IQuad::create(glm::vec2 size) {
 
 void IQuad::create(kvf::Rect<> const& rect, kvf::UvRect const& uv, kvf::Color const color) {
 	auto const vec4_color = color.to_linear();
-	m_vertices[lb_v] = Vertex{.position = rect.bottom_left(), .color = vec4_color, .uv = uv.bottom_left()};
-	m_vertices[rb_v] = Vertex{.position = rect.bottom_right(), .color = vec4_color, .uv = uv.bottom_right()};
-	m_vertices[rt_v] = Vertex{.position = rect.top_right(), .color = vec4_color, .uv = uv.top_right()};
-	m_vertices[lt_v] = Vertex{.position = rect.top_left(), .color = vec4_color, .uv = uv.top_left()};
+	auto vertices = Vertices{};
+	vertices[lb_v] = Vertex{.position = rect.bottom_left(), .color = vec4_color, .uv = uv.bottom_left()};
+	vertices[rb_v] = Vertex{.position = rect.bottom_right(), .color = vec4_color, .uv = uv.bottom_right()};
+	vertices[rt_v] = Vertex{.position = rect.top_right(), .color = vec4_color, .uv = uv.top_right()};
+	vertices[lt_v] = Vertex{.position = rect.top_left(), .color = vec4_color, .uv = uv.top_left()};
+	store(vertices);
+}
+
+auto IQuad::get_uv() const -> kvf::UvRect { return {.lt = get_vertex(lt_v).uv, .rb = get_vertex(rb_v).uv}; }
+
+void IQuad::store(Vertices const& vertices) {
+	if (m_requested_format != VertexFormat::Packed || !std::ranges::all_of(vertices, &PackedVertex::can_pack)) {
+		m_vertices = vertices;
+		return;
+	}
+	auto packed = PackedVertices{};
+	std::ranges::transform(vertices, packed.begin(), &PackedVertex::pack);
+	m_vertices = packed;
+}
+
+auto IQuad::get_vertex(std::size_t const index) const -> Vertex {
+	if (auto const* vertices = std::get_if<Vertices>(&m_vertices)) { return (*vertices)[index]; }
+	return std::get<PackedVertices>(m_vertices)[index].unpack();
 }
 
-auto IQuad::get_uv() const -> kvf::UvRect { return {.lt = m_vertices[lt_v].uv, .rb = m_vertices[rb_v].uv}; }
+auto Quad::list_indices(std::size_t count) -> std::span<std::uint32_t const> {
+	static auto const ret = build_list_indices();
+	count = std::min(count, max_list_quads_v);
+	return std::span{ret}.first(count * indices_v.size());
+}
 } // namespace le::shape
@@ -6,6 +6,8 @@
 namespace le::shape {
 void Sector::create(float const diameter, Params const& params) {
 	m_verts.clear();
+	m_packed.clear();
+	m_bounds = {};
 	if (!kvf::is_positive(diameter)) {
 		m_diameter = 0.0f;
 		return;
@@ -25,5 +27,8 @@ void Sector::create(float const diameter, Params const& params) {
 		vertex.uv = {cos + 0.5f, 0.5f - sin};
 		m_verts.vertices.push_back(vertex);
 	}
+
+	m_bounds = vertex_bounds(m_verts.vertices, glm::mat4{1.0f});
+	store_vertices(params.vertex_format, m_verts.vertices, m_packed);
 }
 } // namespace le::shape
@@ -6,6 +6,8 @@
 namespace le::shape {
 void SuperEllipse::create(glm::vec2 const size, Params const& params) {
 	m_verts.clear();
+	m_packed.clear();
+	m_bounds = {};
 	m_params = params;
 	if (!kvf::is_positive(size)) {
 		m_size = {};
@@ -28,5 +30,8 @@ void SuperEllipse::create(glm::vec2 const size, Params const& params) {
 		vertex.uv = {(vertex.position.x / size.x) + 0.5f, 0.5f - (vertex.position.y / size.y)};
 		m_verts.vertices.push_back(vertex);
 	}
+
+	m_bounds = vertex_bounds(m_verts.vertices, glm::mat4{1.0f});
+	store_vertices(params.vertex_format, m_verts.vertices, m_packed);
 }
 } // namespace le::shape
@@ -5,4 +5,9 @@
 namespace le::spirv {
 [[nodiscard]] auto vert() -> std::span<std::uint32_t const>;
 [[nodiscard]] auto frag() -> std::span<std::uint32_t const>;
+[[nodiscard]] auto compact_vert() -> std::span<std::uint32_t const>;
+[[nodiscard]] auto glyph_vert() -> std::span<std::uint32_t const>;
+[[nodiscard]] auto sdf_frag() -> std::span<std::uint32_t const>;
+[[nodiscard]] auto texture_table_vert() -> std::span<std::uint32_t const>;
+[[nodiscard]] auto texture_table_frag() -> std::span<std::uint32_t const>;
 } // namespace le::spirv
@@ -0,0 +1,70 @@
+#include <array>
+#include <cstdint>
+#include <span>
+
+namespace le::spirv {
+namespace {
+auto const g_code = std::array<std::uint32_t, 752>{
+	119734787,	65536,		851979,		96,			0,			131089,		1,			393227,		1,			1280527431, 1685353262, 808793134,	0,
+	196622,		0,			1,			786447,		0,			2,			1852399981, 0,			3,			4,			5,			6,			7,
+	8,			9,			196611,		2,			450,		655364,		1197427783, 1279741775, 1885560645, 1953718128, 1600482425, 1701734764, 1919509599,
+	1769235301, 25974,		524292,		1197427783, 1279741775, 1852399429, 1685417059, 1768185701, 1952671090, 6649449,	262149,		2,			1852399981,
+	0,			458757,		10,			1650946675, 1601139807, 1701734764, 1982362209, 102,		327685,		11,			1953721929, 1701015137, 0,
+	327686,		11,			0,			1701734764, 29281,		393222,		11,			1,			1851880052, 1952541811, 7237481,	327686,		11,
+	2,			1953393012, 0,			327686,		11,			3,			1684300144, 6778473,	327685,		12,			1953721929, 1701015137, 115,
+	393222,		12,			0,			1953721961, 1701015137, 115,		196613,		13,			0,			458757,		3,			1230990439, 1635021678,
+	1231381358, 2019910766, 0,			262149,		4,			1601467759, 30325,		262149,		5,			1987403617, 0,			327685,		6,
+	1601467759, 1953393012, 0,			262149,		7,			1868783457, 7499628,	262149,		8,			1869635425, 115,		393221,		14,
+	1348430951, 1700164197, 2019914866, 0,			393222,		14,			0,			1348430951, 1953067887, 7237481,	458758,		14,			1,
+	1348430951, 1953393007, 1702521171, 0,			458758,		14,			2,			1130327143, 1148217708, 1635021673, 6644590,	458758,		14,
+	3,			1130327143, 1147956341, 1635021673, 6644590,	196613,		9,			0,			262149,		15,			2003134806, 0,			393222,
+	15,			0,			1601462637, 2003134838, 0,			393222,		15,			1,			1601462637, 1785688688, 0,			196613,		16,
+	0,			327752,		11,			0,			35,			0,			327752,		11,			1,			35,			16,			327752,		11,
+	2,			35,			24,			327752,		11,			3,			35,			28,			262215,		17,			6,			32,			196679,
+	12,			3,			262216,		12,			0,			24,			327752,		12,			0,			35,			0,			196679,		13,
+	24,			262215,		13,			33,			0,			262215,		13,			34,			1,			262215,		3,			11,			43,
+	262215,		4,			30,			1,			262215,		5,			30,			2,			262215,		6,			30,			0,			262215,
+	7,			30,			1,			262215,		8,			30,			0,			196679,		14,			2,			327752,		14,			0,
+	11,			0,			327752,		14,			1,			11,			1,			327752,		14,			2,			11,			3,			327752,
+	14,			3,			11,			4,			196679,		15,			2,			262216,		15,			0,			5,			327752,		15,
+	0,			7,			16,			327752,		15,			0,			35,			0,			262216,		15,			1,			5,			327752,
+	15,			1,			7,			16,			327752,		15,			1,			35,			64,			262215,		16,			33,			0,
+	262215,		16,			34,			0,			131091,		18,			196641,		19,			18,			196630,		20,			32,			262167,
+	21,			20,			2,			262167,		22,			20,			3,			262167,		23,			20,			4,			262168,		24,
+	21,			2,			262168,		25,			23,			4,			262165,		26,			32,			0,			262165,		27,			32,
+	1,			131092,		28,			262167,		29,			28,			3,			262177,		30,			23,			23,			393246,		11,
+	23,			21,			26,			26,			196637,		17,			11,			196638,		12,			17,			262176,		31,			2,
+	12,			262203,		31,			13,			2,			262187,		27,			32,			0,			262187,		27,			33,			1,
+	262176,		34,			1,			27,			262203,		34,			3,			1,			262176,		35,			2,			11,			262176,
+	36,			3,			21,			262203,		36,			4,			3,			262176,		37,			1,			21,			262203,		37,
+	5,			1,			262203,		37,			8,			1,			262176,		38,			3,			23,			262203,		38,			6,
+	3,			262176,		39,			1,			23,			262203,		39,			7,			1,			262187,		20,			40,			0,
+	262187,		20,			41,			1065353216, 262187,		20,			42,			1095678034, 262187,		20,			43,			1029785518, 262187,
+	20,			44,			1065814589, 262187,		20,			45,			1075419546, 262187,		20,			46,			1025879782, 393260,		22,
+	47,			42,			42,			42,			393260,		22,			48,			43,			43,			43,			393260,		22,			49,
+	44,			44,			44,			393260,		22,			50,			45,			45,			45,			393260,		22,			51,			46,
+	46,			46,			262187,		26,			52,			1,			262172,		53,			20,			52,			393246,		14,			23,
+	20,			53,			53,			262176,		54,			3,			14,			262203,		54,			9,			3,			262174,		15,
+	25,			25,			262176,		55,			2,			15,			262203,		55,			16,			2,			262176,		56,			2,
+	25,			327734,		18,			2,			0,			19,			131320,		57,			262205,		27,			58,			3,			393281,
+	35,			59,			13,			32,			58,			262205,		11,			60,			59,			262205,		21,			61,			5,
+	196670,		4,			61,			262205,		23,			62,			7,			327761,		26,			63,			60,			2,			393228,
+	23,			64,			1,			64,			63,			327737,		23,			65,			10,			64,			327813,		23,			66,
+	62,			65,			196670,		6,			66,			327761,		23,			67,			60,			0,			458831,		21,			68,
+	67,			67,			0,			1,			458831,		21,			69,			67,			67,			2,			3,			327760,		24,
+	70,			68,			69,			262205,		21,			71,			8,			327825,		21,			72,			70,			71,			327761,
+	21,			73,			60,			1,			327809,		21,			74,			72,			73,			327761,		20,			75,			74,
+	0,			327761,		20,			76,			74,			1,			458832,		23,			77,			75,			76,			40,			41,
+	327745,		56,			78,			16,			33,			262205,		25,			79,			78,			327745,		56,			80,			16,
+	32,			262205,		25,			81,			80,			327826,		25,			82,			79,			81,			327825,		23,			83,
+	82,			77,			327745,		38,			84,			9,			32,			196670,		84,			83,			65789,		65592,		327734,
+	23,			10,			0,			30,			196663,		23,			85,			131320,		86,			524367,		22,			87,			85,
+	85,			0,			1,			2,			327816,		22,			88,			87,			47,			327809,		22,			89,			87,
+	48,			327816,		22,			90,			89,			49,			458764,		22,			91,			1,			26,			90,			50,
+	327868,		29,			92,			87,			51,			393385,		22,			93,			92,			88,			91,			327761,		20,
+	94,			85,			3,			327760,		23,			95,			93,			94,			131326,		95,			65592,
+};
+} // namespace
+
+auto compact_vert() -> std::span<std::uint32_t const> { return g_code; }
+} // namespace le::spirv
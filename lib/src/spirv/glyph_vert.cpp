@@ -0,0 +1,75 @@
+#include <array>
+#include <cstdint>
+#include <span>
+
+namespace le::spirv {
+namespace {
+auto const g_code = std::array<std::uint32_t, 814>{
+	119734787,	65536,		851979,		97,			0,			131089,		1,			393227,		1,			1280527431, 1685353262, 808793134,	0,
+	196622,		0,			1,			655375,		0,			2,			1852399981, 0,			3,			4,			5,			6,			7,
+	196611,		2,			450,		655364,		1197427783, 1279741775, 1885560645, 1953718128, 1600482425, 1701734764, 1919509599, 1769235301, 25974,
+	524292,		1197427783, 1279741775, 1852399429, 1685417059, 1768185701, 1952671090, 6649449,	262149,		2,			1852399981, 0,			262149,
+	8,			1887005767, 104,		262150,		8,			0,			29804,		262150,		8,			1,			25202,		262150,		8,
+	2,			30325,		327686,		8,			3,			1869377379, 114,		327686,		8,			4,			1684300144, 6778473,	262149,
+	9,			1887005767, 29544,		327686,		9,			0,			1887005799, 29544,		196613,		10,			0,			458757,		3,
+	1230990439, 1635021678, 1231381358, 2019910766, 0,			393221,		4,			1449094247, 1702130277, 1684949368, 30821,		262149,		5,
+	1601467759, 30325,		327685,		6,			1601467759, 1953393012, 0,			327685,		11,			1953721929, 1701015137, 0,			393222,
+	11,			0,			1601462637, 1819438967, 100,		327686,		11,			1,			1953393012, 0,			327685,		12,			1953721929,
+	1701015137, 115,		393222,		12,			0,			1953721961, 1701015137, 115,		196613,		13,			0,			262149,		14,
+	2003134806, 0,			393222,		14,			0,			1601462637, 2003134838, 0,			393222,		14,			1,			1601462637, 1785688688,
+	0,			196613,		15,			0,			393221,		16,			1348430951, 1700164197, 2019914866, 0,			393222,		16,			0,
+	1348430951, 1953067887, 7237481,	458758,		16,			1,			1348430951, 1953393007, 1702521171, 0,			458758,		16,			2,
+	1130327143, 1148217708, 1635021673, 6644590,	458758,		16,			3,			1130327143, 1147956341, 1635021673, 6644590,	196613,		7,
+	0,			327752,		8,			0,			35,			0,			327752,		8,			1,			35,			8,			327752,		8,
+	2,			35,			16,			327752,		8,			3,			35,			24,			327752,		8,			4,			35,			28,
+	262215,		17,			6,			32,			196679,		9,			3,			262216,		9,			0,			24,			327752,		9,
+	0,			35,			0,			196679,		10,			24,			262215,		10,			33,			0,			262215,		10,			34,
+	1,			262215,		3,			11,			43,			262215,		4,			11,			42,			262215,		5,			30,			1,
+	262215,		6,			30,			0,			262216,		11,			0,			5,			327752,		11,			0,			7,			16,
+	327752,		11,			0,			35,			0,			327752,		11,			1,			35,			64,			262215,		18,			6,
+	80,			196679,		12,			3,			262216,		12,			0,			24,			327752,		12,			0,			35,			0,
+	196679,		13,			24,			262215,		13,			33,			2,			262215,		13,			34,			1,			196679,		14,
+	2,			262216,		14,			0,			5,			327752,		14,			0,			7,			16,			327752,		14,			0,
+	35,			0,			262216,		14,			1,			5,			327752,		14,			1,			7,			16,			327752,		14,
+	1,			35,			64,			262215,		15,			33,			0,			262215,		15,			34,			0,			196679,		16,
+	2,			327752,		16,			0,			11,			0,			327752,		16,			1,			11,			1,			327752,		16,
+	2,			11,			3,			327752,		16,			3,			11,			4,			131091,		19,			196641,		20,			19,
+	196630,		21,			32,			262167,		22,			21,			2,			262167,		23,			21,			4,			262168,		24,
+	23,			4,			262165,		25,			32,			0,			262165,		26,			32,			1,			262167,		27,			25,
+	2,			458782,		8,			22,			22,			27,			25,			25,			196637,		17,			8,			196638,		9,
+	17,			262176,		28,			2,			9,			262203,		28,			10,			2,			262187,		26,			29,			0,
+	262187,		26,			30,			1,			262187,		26,			31,			2,			262187,		26,			32,			3,			262176,
+	33,			1,			26,			262203,		33,			3,			1,			262203,		33,			4,			1,			262176,		34,
+	2,			8,			262176,		35,			3,			22,			262203,		35,			5,			3,			262176,		36,			3,
+	23,			262203,		36,			6,			3,			262174,		11,			24,			23,			196637,		18,			11,			196638,
+	12,			18,			262176,		37,			2,			12,			262203,		37,			13,			2,			262176,		38,			2,
+	11,			262174,		14,			24,			24,			262176,		39,			2,			14,			262203,		39,			15,			2,
+	262176,		40,			2,			24,			262187,		21,			41,			0,			262187,		21,			42,			1065353216, 262187,
+	25,			43,			1,			262172,		44,			21,			43,			393246,		16,			23,			21,			44,			44,
+	262176,		45,			3,			16,			262203,		45,			7,			3,			327734,		19,			2,			0,			20,
+	131320,		46,			262205,		26,			47,			3,			393281,		34,			48,			10,			29,			47,			262205,
+	8,			49,			48,			262205,		26,			50,			4,			327875,		26,			51,			50,			31,			393281,
+	38,			52,			13,			29,			51,			262205,		11,			53,			52,			327879,		26,			54,			50,
+	32,			327879,		26,			55,			54,			30,			327875,		26,			56,			54,			30,			262255,		21,
+	57,			55,			262255,		21,			58,			56,			327760,		22,			59,			57,			58,			327761,		27,
+	60,			49,			2,			327761,		25,			61,			60,			0,			327761,		25,			62,			60,			1,
+	393228,		22,			63,			1,			62,			61,			393228,		22,			64,			1,			62,			62,			327761,
+	21,			65,			63,			0,			327761,		21,			66,			63,			1,			327761,		21,			67,			64,
+	0,			327761,		21,			68,			64,			1,			327760,		22,			69,			65,			68,			327760,		22,
+	70,			67,			66,			524300,		22,			71,			1,			46,			69,			70,			59,			196670,		5,
+	71,			327761,		25,			72,			49,			3,			393228,		23,			73,			1,			64,			72,			327761,
+	23,			74,			53,			1,			327813,		23,			75,			73,			74,			196670,		6,			75,			327761,
+	22,			76,			49,			0,			327761,		22,			77,			49,			1,			327761,		21,			78,			76,
+	0,			327761,		21,			79,			76,			1,			327761,		21,			80,			77,			0,			327761,		21,
+	81,			77,			1,			327760,		22,			82,			78,			81,			327760,		22,			83,			80,			79,
+	524300,		22,			84,			1,			46,			82,			83,			59,			327761,		21,			85,			84,			0,
+	327761,		21,			86,			84,			1,			458832,		23,			87,			85,			86,			41,			42,			327761,
+	24,			88,			53,			0,			327825,		23,			89,			88,			87,			327745,		40,			90,			15,
+	30,			262205,		24,			91,			90,			327745,		40,			92,			15,			29,			262205,		24,			93,
+	92,			327826,		24,			94,			91,			93,			327825,		23,			95,			94,			89,			327745,		36,
+	96,			7,			29,			196670,		96,			95,			65789,		65592,
+};
+} // namespace
+
+auto glyph_vert() -> std::span<std::uint32_t const> { return g_code; }
+} // namespace le::spirv
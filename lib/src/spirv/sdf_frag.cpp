@@ -0,0 +1,31 @@
+#include <array>
+#include <cstdint>
+#include <span>
+
+namespace le::spirv {
+namespace {
+auto const g_code = std::array<std::uint32_t, 240>{
+	119734787, 65536,	   851979,	   35,		   0,		   131089,	   1,		   393227,	   1,		   1280527431, 1685353262, 808793134,  0,
+	196622,	   0,		   1,		   524303,	   4,		   2,		   1852399981, 0,		   3,		   4,		   5,		   196624,	   2,
+	7,		   196611,	   2,		   450,		   655364,	   1197427783, 1279741775, 1885560645, 1953718128, 1600482425, 1701734764, 1919509599, 1769235301,
+	25974,	   524292,	   1197427783, 1279741775, 1852399429, 1685417059, 1768185701, 1952671090, 6649449,	   262149,	   2,		   1852399981, 0,
+	327685,	   3,		   1601467759, 1869377379, 114,		   262149,	   4,		   1952411241, 7630441,	   196613,	   6,		   7890292,	   262149,
+	5,		   1969188457, 118,		   262215,	   3,		   30,		   0,		   262215,	   4,		   30,		   0,		   262215,	   6,
+	33,		   1,		   262215,	   6,		   34,		   1,		   262215,	   5,		   30,		   1,		   131091,	   7,		   196641,
+	8,		   7,		   196630,	   9,		   32,		   262167,	   10,		   9,		   4,		   262176,	   11,		   3,		   10,
+	262203,	   11,		   3,		   3,		   262176,	   12,		   1,		   10,		   262203,	   12,		   4,		   1,		   262187,
+	9,		   13,		   1065353216, 262187,	   9,		   14,		   1056964608, 262187,	   9,		   15,		   998277249,  589849,	   16,
+	9,		   1,		   0,		   0,		   0,		   1,		   0,		   196635,	   17,		   16,		   262176,	   18,		   0,
+	17,		   262203,	   18,		   6,		   0,		   262167,	   19,		   9,		   2,		   262176,	   20,		   1,		   19,
+	262203,	   20,		   5,		   1,		   327734,	   7,		   2,		   0,		   8,		   131320,	   21,		   262205,	   17,
+	22,		   6,		   262205,	   19,		   23,		   5,		   327767,	   10,		   24,		   22,		   23,		   327761,	   9,
+	25,		   24,		   3,		   262353,	   9,		   26,		   25,		   327813,	   9,		   27,		   14,		   26,		   458764,
+	9,		   28,		   1,		   40,		   27,		   15,		   327811,	   9,		   29,		   14,		   28,		   327809,	   9,
+	30,		   14,		   28,		   524300,	   9,		   31,		   1,		   49,		   29,		   30,		   25,		   262205,	   10,
+	32,		   4,		   458832,	   10,		   33,		   13,		   13,		   13,		   31,		   327813,	   10,		   34,		   32,
+	33,		   196670,	   3,		   34,		   65789,	   65592,
+};
+} // namespace
+
+auto sdf_frag() -> std::span<std::uint32_t const> { return g_code; }
+} // namespace le::spirv
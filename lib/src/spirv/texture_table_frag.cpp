@@ -0,0 +1,33 @@
+#include <array>
+#include <cstdint>
+#include <span>
+
+namespace le::spirv {
+namespace {
+auto const g_code = std::array<std::uint32_t, 263>{
+	119734787,	65536,		851979,		33,			0,			131089,		1,			131089,		5301,		131089,		5307,		524298,		1599492179,
+	1599363141, 1668506980, 1953524082, 1767862895, 2019910766, 6778473,	393227,		1,			1280527431, 1685353262, 808793134,	0,			196622,
+	0,			1,			589839,		4,			2,			1852399981, 0,			3,			4,			5,			6,			196624,		2,
+	7,			196611,		2,			450,		524292,		1163873351, 1851741272, 1853189743, 1919903337, 1970364269, 1718185057, 7497065,	655364,
+	1197427783, 1279741775, 1885560645, 1953718128, 1600482425, 1701734764, 1919509599, 1769235301, 25974,		524292,		1197427783, 1279741775, 1852399429,
+	1685417059, 1768185701, 1952671090, 6649449,	262149,		2,			1852399981, 0,			327685,		3,			1601467759, 1869377379, 114,
+	262149,		4,			1952411241, 7630441,	327685,		7,			1954047348, 1936028277, 0,			327685,		5,			1952411241, 1970567269,
+	25970,		262149,		6,			1969188457, 118,		262215,		3,			30,			0,			262215,		4,			30,			0,
+	262215,		7,			33,			1,			262215,		7,			34,			3,			196679,		5,			14,			262215,		5,
+	30,			2,			196679,		8,			5300,		196679,		9,			5300,		196679,		10,			5300,		262215,		6,
+	30,			1,			131091,		11,			196641,		12,			11,			196630,		13,			32,			262167,		14,			13,
+	4,			262176,		15,			3,			14,			262203,		15,			3,			3,			262176,		16,			1,			14,
+	262203,		16,			4,			1,			589849,		17,			13,			1,			0,			0,			0,			1,			0,
+	196635,		18,			17,			262165,		19,			32,			0,			262187,		19,			20,			16,			262172,		21,
+	18,			20,			262176,		22,			0,			21,			262203,		22,			7,			0,			262176,		23,			1,
+	19,			262203,		23,			5,			1,			262176,		24,			0,			18,			262167,		25,			13,			2,
+	262176,		26,			1,			25,			262203,		26,			6,			1,			327734,		11,			2,			0,			12,
+	131320,		27,			262205,		14,			28,			4,			262205,		19,			29,			5,			262227,		19,			8,
+	29,			327745,		24,			9,			7,			8,			262205,		18,			10,			9,			262205,		25,			30,
+	6,			327767,		14,			31,			10,			30,			327813,		14,			32,			28,			31,			196670,		3,
+	32,			65789,		65592,
+};
+} // namespace
+
+auto texture_table_frag() -> std::span<std::uint32_t const> { return g_code; }
+} // namespace le::spirv
@@ -0,0 +1,64 @@
+#include <array>
+#include <cstdint>
+#include <span>
+
+namespace le::spirv {
+namespace {
+auto const g_code = std::array<std::uint32_t, 674>{
+	119734787,	65536,		851979,		73,			0,			131089,		1,			393227,		1,			1280527431, 1685353262, 808793134,	0,
+	196622,		0,			1,			917519,		0,			2,			1852399981, 0,			3,			4,			5,			6,			7,
+	8,			9,			10,			11,			196611,		2,			450,		655364,		1197427783, 1279741775, 1885560645, 1953718128, 1600482425,
+	1701734764, 1919509599, 1769235301, 25974,		524292,		1197427783, 1279741775, 1852399429, 1685417059, 1768185701, 1952671090, 6649449,	262149,
+	2,			1852399981, 0,			262149,		3,			1601467759, 30325,		262149,		4,			1987403617, 0,			327685,		5,
+	1601467759, 1953393012, 0,			262149,		6,			1868783457, 7499628,	327685,		12,			1953721929, 1701015137, 0,			393222,
+	12,			0,			1601462637, 1819438967, 100,		327686,		12,			1,			1953393012, 0,			327685,		13,			1953721929,
+	1701015137, 115,		393222,		13,			0,			1953721961, 1701015137, 115,		196613,		14,			0,			458757,		10,
+	1230990439, 1635021678, 1231381358, 2019910766, 0,			327685,		7,			1601467759, 1954047348, 6648437,	393221,		15,			1954047316,
+	1231385205, 1667851374, 29541,		458758,		15,			0,			1954047348, 1600483957, 1768189545, 7562595,	196613,		16,			0,
+	393221,		8,			1449094247, 1702130277, 1684949368, 30821,		393221,		17,			1348430951, 1700164197, 2019914866, 0,			393222,
+	17,			0,			1348430951, 1953067887, 7237481,	458758,		17,			1,			1348430951, 1953393007, 1702521171, 0,			458758,
+	17,			2,			1130327143, 1148217708, 1635021673, 6644590,	458758,		17,			3,			1130327143, 1147956341, 1635021673, 6644590,
+	196613,		9,			0,			262149,		18,			2003134806, 0,			393222,		18,			0,			1601462637, 2003134838, 0,
+	393222,		18,			1,			1601462637, 1785688688, 0,			196613,		19,			0,			262149,		11,			1869635425, 115,
+	262215,		3,			30,			1,			262215,		4,			30,			2,			262215,		5,			30,			0,			262215,
+	6,			30,			1,			262216,		12,			0,			5,			327752,		12,			0,			7,			16,			327752,
+	12,			0,			35,			0,			327752,		12,			1,			35,			64,			262215,		20,			6,			80,
+	196679,		13,			3,			262216,		13,			0,			24,			327752,		13,			0,			35,			0,			196679,
+	14,			24,			262215,		14,			33,			0,			262215,		14,			34,			1,			262215,		10,			11,
+	43,			196679,		7,			14,			262215,		7,			30,			2,			262215,		21,			6,			4,			196679,
+	15,			3,			262216,		15,			0,			24,			327752,		15,			0,			35,			0,			196679,		16,
+	24,			262215,		16,			33,			0,			262215,		16,			34,			3,			262215,		8,			11,			42,
+	196679,		17,			2,			327752,		17,			0,			11,			0,			327752,		17,			1,			11,			1,
+	327752,		17,			2,			11,			3,			327752,		17,			3,			11,			4,			196679,		18,			2,
+	262216,		18,			0,			5,			327752,		18,			0,			7,			16,			327752,		18,			0,			35,
+	0,			262216,		18,			1,			5,			327752,		18,			1,			7,			16,			327752,		18,			1,
+	35,			64,			262215,		19,			33,			0,			262215,		19,			34,			0,			262215,		11,			30,
+	0,			131091,		22,			196641,		23,			22,			196630,		24,			32,			262167,		25,			24,			2,
+	262176,		26,			3,			25,			262203,		26,			3,			3,			262176,		27,			1,			25,			262203,
+	27,			4,			1,			262203,		27,			11,			1,			262187,		24,			28,			0,			262187,		24,
+	29,			1065353216, 262167,		30,			24,			4,			262168,		31,			30,			4,			262165,		32,			32,
+	0,			262165,		33,			32,			1,			262187,		33,			34,			0,			262187,		33,			35,			1,
+	262187,		32,			36,			1,			262176,		37,			3,			30,			262203,		37,			5,			3,			262176,
+	38,			1,			30,			262203,		38,			6,			1,			262174,		12,			31,			30,			196637,		20,
+	12,			196638,		13,			20,			262176,		39,			2,			13,			262203,		39,			14,			2,			262176,
+	40,			1,			33,			262203,		40,			10,			1,			262203,		40,			8,			1,			262176,		41,
+	2,			12,			262176,		42,			3,			32,			262203,		42,			7,			3,			196637,		21,			32,
+	196638,		15,			21,			262176,		43,			2,			15,			262203,		43,			16,			2,			262176,		44,
+	2,			32,			262172,		45,			24,			36,			393246,		17,			30,			24,			45,			45,			262176,
+	46,			3,			17,			262203,		46,			9,			3,			262174,		18,			31,			31,			262176,		47,
+	2,			18,			262203,		47,			19,			2,			262176,		48,			2,			31,			327734,		22,			2,
+	0,			23,			131320,		49,			262205,		33,			50,			10,			393281,		41,			51,			14,			34,
+	50,			262205,		12,			52,			51,			327761,		31,			53,			52,			0,			327761,		30,			54,
+	52,			1,			262205,		25,			55,			4,			196670,		3,			55,			262205,		30,			56,			6,
+	327813,		30,			57,			56,			54,			196670,		5,			57,			262205,		33,			58,			8,			393281,
+	44,			59,			16,			34,			58,			262205,		32,			60,			59,			196670,		7,			60,			262205,
+	25,			61,			11,			327761,		24,			62,			61,			0,			327761,		24,			63,			61,			1,
+	458832,		30,			64,			62,			63,			28,			29,			327825,		30,			65,			53,			64,			327745,
+	48,			66,			19,			35,			262205,		31,			67,			66,			327745,		48,			68,			19,			34,
+	262205,		31,			69,			68,			327826,		31,			70,			67,			69,			327825,		30,			71,			70,
+	65,			327745,		37,			72,			9,			34,			196670,		72,			71,			65789,		65592,
+};
+} // namespace
+
+auto texture_table_vert() -> std::span<std::uint32_t const> { return g_code; }
+} // namespace le::spirv
@@ -1,9 +1,13 @@
 #include "le2d/text/line_input.hpp"
 #include "klib/debug/assert.hpp"
+#include "kvf/is_positive.hpp"
+#include "le2d/profile.hpp"
+#include <algorithm>
 
 namespace le {
 namespace {
 [[nodiscard]] constexpr auto is_space(char const c) { return c == ' ' || c == '\t'; }
+[[nodiscard]] constexpr auto is_single_glyph(char const c) { return (static_cast<unsigned char>(c) & 0x80) == 0 && c != '\n'; }
 } // namespace
 
 LineInput::LineInput(gsl::not_null<IFont*> font, TextHeight const height) : m_atlas(&font->get_atlas(height)) {}
@@ -19,16 +23,18 @@ void LineInput::set_string(std::string line) {
 
 void LineInput::append(std::string_view const str) {
 	if (str.empty()) { return; }
+	auto const edit = m_line.size();
 	m_line.append(str);
 	set_cursor(int(m_line.size()));
-	update();
+	update_from(edit);
 }
 
 void LineInput::write(char const ch) {
 	KLIB_ASSERT(m_cursor >= 0 && m_cursor <= int(m_line.size()));
-	m_line.insert(std::size_t(m_cursor), 1, ch);
+	auto const edit = std::size_t(m_cursor);
+	m_line.insert(edit, 1, ch);
 	++m_cursor;
-	update();
+	update_from(edit);
 }
 
 void LineInput::backward_delete() {
@@ -36,14 +42,14 @@ void LineInput::backward_delete() {
 	KLIB_ASSERT(m_cursor > 0 && m_cursor <= int(m_line.size()));
 	m_line.erase(std::size_t(m_cursor - 1), 1);
 	--m_cursor;
-	update();
+	update_from(std::size_t(m_cursor));
 }
 
 void LineInput::forward_delete() {
 	if (m_cursor == int(m_line.size())) { return; }
 	KLIB_ASSERT(m_cursor >= 0 && m_cursor <= int(m_line.size()));
 	m_line.erase(std::size_t(m_cursor), 1);
-	update();
+	update_from(std::size_t(m_cursor));
 }
 
 void LineInput::forward_word() {
@@ -67,20 +73,43 @@ void LineInput::set_cursor(int const cursor) {
 
 void LineInput::move_cursor(int const delta) { set_cursor(get_cursor() + delta); }
 
-void LineInput::update() {
-	m_geometry.clear_vertices();
+void LineInput::update() { update_from(0); }
 
+void LineInput::update_from(std::size_t const edit) {
+	LE_PROFILE_ZONE("LineInput::update");
 	if (m_line.empty()) {
+		m_geometry.clear_vertices();
+		m_glyph_layouts.clear();
 		m_cursor_x = 0.0f;
 		m_cursor = 0;
 		m_size = {};
 		return;
 	}
 
-	m_glyph_layouts.clear();
-	m_next_glyph_x = m_atlas->push_layouts(m_glyph_layouts, m_line).x;
+	// restart one glyph before the edit, so that its kerning with the edited glyph is applied.
+	auto restart = edit > 0 ? edit - 1 : 0;
+	if (m_generation != m_atlas->get_generation()) {
+		// the atlas was rebuilt (face / page changed): kept glyph metrics and UVs are stale.
+		m_generation = m_atlas->get_generation();
+		restart = 0;
+	}
+	// kept layouts must map 1:1 to characters (as the cursor assumes), restart from scratch if that doesn't hold.
+	auto const prefix = std::string_view{m_line}.substr(0, restart + 1);
+	if (restart >= m_glyph_layouts.size() || !std::ranges::all_of(prefix, [](char const c) { return is_single_glyph(c); })) { restart = 0; }
+	auto const origin = restart > 0 ? m_glyph_layouts[restart].baseline : glm::vec2{};
+	auto const kept_quads = std::ranges::count_if(std::span{m_glyph_layouts}.first(restart),
+												  [](kvf::ttf::GlyphLayout const& layout) { return kvf::is_positive(layout.glyph->size); });
+
+	m_glyph_layouts.resize(restart);
+	m_geometry.truncate_glyphs(std::size_t(kept_quads));
+
+	m_suffix_layouts.clear();
+	m_next_glyph_x = origin.x + m_atlas->push_layouts(m_suffix_layouts, std::string_view{m_line}.substr(restart)).x;
+	for (auto& layout : m_suffix_layouts) { layout.baseline += origin; }
+	m_glyph_layouts.insert(m_glyph_layouts.end(), m_suffix_layouts.begin(), m_suffix_layouts.end());
+
 	m_size = kvf::ttf::glyph_bounds(m_glyph_layouts).size();
-	m_geometry.append_glyphs(m_glyph_layouts);
+	m_geometry.append_glyphs(m_suffix_layouts);
 	update_cursor_x();
 }
 
@@ -1,4 +1,6 @@
 #include "le2d/text/text_buffer.hpp"
+#include "le2d/profile.hpp"
+#include "le2d/text/util.hpp"
 #include <algorithm>
 
 namespace le {
@@ -6,29 +8,72 @@ TextBuffer::TextBuffer(gsl::not_null<IFontAtlas*> atlas, std::size_t const limit
 	: m_atlas(atlas), m_limit(limit), m_n_line_spacing(n_line_spacing) {}
 
 void TextBuffer::push_front(std::span<std::string> lines, kvf::Color color) {
-	for (auto& line : lines) { m_lines.push_front(Line{.text = std::move(line), .color = color}); }
-	while (m_lines.size() > m_limit) { m_lines.pop_back(); }
-	refresh();
+	LE_PROFILE_ZONE("TextBuffer::push_front");
+	for (auto const& line : lines) { push_line(line, color); }
+	while (m_lines.size() > m_limit) { pop_line(); }
+
+	// dead glyphs are compacted once they outnumber live ones, amortized O(1) per line.
+	if (m_pushed >= rebase_lines_v || (m_begin > 0 && m_begin >= m_glyphs.size() - m_begin)) { rebase(); }
+
+	m_size.x = 0.0f;
+	for (auto const& line : m_lines) { m_size.x = std::max(m_size.x, line.width); }
+	m_size.y = float(m_lines.size()) * get_line_height();
+}
+
+auto TextBuffer::get_offset() const -> glm::vec2 { return {0.0f, float(m_pushed) * get_line_height()}; }
+
+auto TextBuffer::to_instance(RenderInstance instance) const -> RenderInstance {
+	auto const offset = glm::vec4{get_offset(), 0.0f, 0.0f};
+	instance.transform.position += glm::vec2{instance.transform.to_model() * offset};
+	return instance;
+}
+
+auto TextBuffer::to_offset_primitive() const -> Primitive {
+	return Primitive{
+		.glyphs = std::span{m_glyphs}.subspan(m_begin),
+		.topology = vk::PrimitiveTopology::eTriangleList,
+		.texture = &m_atlas->get_texture(),
+	};
+}
+
+void TextBuffer::draw(IRenderer& renderer, RenderInstance const& instance) const {
+	auto const offset_instance = to_instance(instance);
+	renderer.draw(to_offset_primitive(), {&offset_instance, 1});
+}
+
+auto TextBuffer::get_line_height() const -> float { return m_n_line_spacing * float(m_atlas->get_height()); }
+
+void TextBuffer::push_line(std::string_view const text, kvf::Color const color) {
+	// lines are written below the previous ones, get_offset() moves the newest back to y = 0.
+	++m_pushed;
+	auto line = Line{};
+	if (!text.empty()) {
+		m_layouts.clear();
+		m_atlas->push_layouts(m_layouts, text);
+		auto const& last_glyph = m_layouts.back();
+		line.width = last_glyph.baseline.x + last_glyph.glyph->size.x;
+
+		auto const first_glyph = m_glyphs.size();
+		auto const position = glm::vec2{0.0f, -float(m_pushed) * get_line_height()};
+		util::write_glyph_instances(m_glyphs, m_layouts, position, color);
+		line.glyph_count = m_glyphs.size() - first_glyph;
+	}
+	m_lines.push_front(line);
+}
+
+void TextBuffer::pop_line() {
+	m_begin += m_lines.back().glyph_count;
+	m_lines.pop_back();
 }
 
-auto TextBuffer::to_primitive() const -> Primitive { return m_geometry.to_primitive(m_atlas->get_texture()); }
-
-void TextBuffer::refresh() {
-	m_geometry.clear_vertices();
-	m_size = {};
-
-	auto pos = glm::vec2{};
-	for (auto const& line : m_lines) {
-		if (!line.text.empty()) {
-			m_layouts.clear();
-			m_atlas->push_layouts(m_layouts, line.text);
-			auto const& last_glyph = m_layouts.back();
-			m_size.x = std::max(m_size.x, last_glyph.baseline.x + last_glyph.glyph->size.x);
-			m_geometry.append_glyphs(m_layouts, pos, line.color);
-		}
-		pos.x = 0.0f;
-		pos.y += m_n_line_spacing * float(m_atlas->get_height());
-		m_size.y = pos.y;
+void TextBuffer::rebase() {
+	auto const dy = get_offset().y;
+	m_glyphs.erase(m_glyphs.begin(), m_glyphs.begin() + std::ptrdiff_t(m_begin));
+	for (auto& glyph : m_glyphs) {
+		glyph.lt.y += dy;
+		glyph.rb.y += dy;
 	}
+	m_begin = 0;
+	m_pushed = 0;
 }
 } // namespace le
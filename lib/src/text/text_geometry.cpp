@@ -1,15 +1,41 @@
 #include "le2d/text/text_geometry.hpp"
 #include "le2d/text/util.hpp"
+#include <glm/common.hpp>
+#include <algorithm>
 
 namespace le {
-void TextGeometry::append_glyphs(std::span<kvf::ttf::GlyphLayout const> layouts, glm::vec2 const offset, kvf::Color const color) {
-	util::write_glyphs(m_vertices, layouts, offset, color);
+void TextGeometry::append_glyphs(std::span<kvf::ttf::GlyphLayout const> layouts, glm::vec2 const offset, kvf::Color const color, float const scale) {
+	auto const first_glyph = m_glyphs.size();
+	util::write_glyph_instances(m_glyphs, layouts, offset, color, scale);
+	if (first_glyph == m_glyphs.size()) { return; }
+	extend_bounds(first_glyph);
+}
+
+void TextGeometry::clear_vertices() {
+	m_glyphs.clear();
+	m_bounds = {};
+}
+
+void TextGeometry::truncate_glyphs(std::size_t const count) {
+	if (count >= m_glyphs.size()) { return; }
+	m_glyphs.resize(count);
+	m_bounds = {};
+	if (count > 0) { extend_bounds(0); }
+}
+
+void TextGeometry::extend_bounds(std::size_t const first_glyph) {
+	auto const bounds = vertex_bounds(std::span{m_glyphs}.subspan(first_glyph), glm::mat4{1.0f});
+	if (first_glyph == 0) {
+		m_bounds = bounds;
+		return;
+	}
+	m_bounds.lt = {std::min(m_bounds.lt.x, bounds.lt.x), std::max(m_bounds.lt.y, bounds.lt.y)};
+	m_bounds.rb = {std::max(m_bounds.rb.x, bounds.rb.x), std::min(m_bounds.rb.y, bounds.rb.y)};
 }
 
 auto TextGeometry::to_primitive(ITexture const& font_atlas) const -> Primitive {
 	return Primitive{
-		.vertices = m_vertices.vertices,
-		.indices = m_vertices.indices,
+		.glyphs = m_glyphs,
 		.topology = vk::PrimitiveTopology::eTriangleList,
 		.texture = &font_atlas,
 	};
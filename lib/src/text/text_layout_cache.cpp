@@ -0,0 +1,52 @@
+#include "le2d/text/text_layout_cache.hpp"
+#include "klib/hash_combine.hpp"
+#include "le2d/profile.hpp"
+#include <algorithm>
+
+namespace le {
+auto TextLayoutCache::get_layout(IFontAtlas const& atlas, std::string_view const text, float const n_line_height) -> Layout const& {
+	auto const generation = atlas.get_generation();
+	auto const height = atlas.get_height();
+	auto const hash = klib::make_combined_hash(generation, height, text, n_line_height);
+	if (auto const it = m_map.find(hash); it != m_map.end()) {
+		auto const entry = it->second;
+		if (entry->generation == generation && entry->height == height && entry->text == text && entry->n_line_height == n_line_height) {
+			++m_stats.hits;
+			m_entries.splice(m_entries.begin(), m_entries, entry);
+			return entry->layout;
+		}
+		// hash collision: replace the existing entry.
+		m_entries.erase(entry);
+		m_map.erase(it);
+	}
+
+	LE_PROFILE_ZONE("TextLayoutCache::get_layout");
+	++m_stats.misses;
+	if (m_entries.size() >= m_capacity) { evict(m_entries.size() + 1 - m_capacity); }
+
+	auto entry = Entry{.generation = generation, .height = height, .text = std::string{text}, .n_line_height = n_line_height, .hash = hash};
+	atlas.push_layouts(entry.layout.glyphs, text, n_line_height);
+	entry.layout.bounds = kvf::ttf::glyph_bounds(entry.layout.glyphs);
+
+	m_entries.push_front(std::move(entry));
+	m_map.insert_or_assign(hash, m_entries.begin());
+	return m_entries.front().layout;
+}
+
+void TextLayoutCache::set_capacity(std::size_t const capacity) {
+	m_capacity = std::max(capacity, std::size_t{1});
+	if (m_entries.size() > m_capacity) { evict(m_entries.size() - m_capacity); }
+}
+
+void TextLayoutCache::clear() {
+	m_entries.clear();
+	m_map.clear();
+}
+
+void TextLayoutCache::evict(std::size_t count) {
+	for (; count > 0 && !m_entries.empty(); --count) {
+		m_map.erase(m_entries.back().hash);
+		m_entries.pop_back();
+	}
+}
+} // namespace le
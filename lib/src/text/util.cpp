@@ -1,11 +1,26 @@
 #include "le2d/text/util.hpp"
 #include "kvf/is_positive.hpp"
+#include "le2d/profile.hpp"
 #include "le2d/shape/quad.hpp"
 #include <algorithm>
 
 namespace le {
 auto util::clamp(TextHeight height) -> TextHeight { return std::clamp(height, TextHeight::Min, TextHeight::Max); }
 
+void util::write_glyph_instances(std::vector<GlyphInstance>& out, std::span<kvf::ttf::GlyphLayout const> glyphs, glm::vec2 const position,
+								 kvf::Color const color, float const scale) {
+	LE_PROFILE_ZONE("util::write_glyph_instances");
+	out.reserve(out.size() + glyphs.size());
+	for (auto const& layout : glyphs) {
+		if (!kvf::is_positive(layout.glyph->size)) { continue; }
+
+		auto rect = layout.glyph->rect(layout.baseline);
+		rect.lt = position + (rect.lt * scale);
+		rect.rb = position + (rect.rb * scale);
+		out.push_back(GlyphInstance::create(rect, layout.glyph->uv_rect, color));
+	}
+}
+
 void util::write_glyphs(VertexArray& out, std::span<kvf::ttf::GlyphLayout const> glyphs, glm::vec2 const position, kvf::Color const color) {
 	out.reserve(glyphs.size() * shape::Quad::vertex_count_v, glyphs.size() * shape::Quad::indices_v.size());
 	for (auto const& layout : glyphs) {
@@ -3,7 +3,8 @@
 
 namespace le {
 namespace {
-void append_verts(VertexArray& out, std::span<Vertex const> vertices, std::span<std::uint32_t const> indices) {
+template <typename VertexT>
+void append_verts(BasicVertexArray<VertexT>& out, std::span<VertexT const> vertices, std::span<std::uint32_t const> indices) {
 	auto const index_offset = std::uint32_t(out.vertices.size());
 	out.vertices.insert(out.vertices.end(), vertices.begin(), vertices.end());
 	out.indices.reserve(out.indices.size() + indices.size());
@@ -11,18 +12,58 @@ void append_verts(VertexArray& out, std::span<Vertex const> vertices, std::span<
 }
 } // namespace
 
-void VertexArray::reserve(std::size_t const vertex_count, std::size_t const index_count) {
+template <typename VertexT>
+void BasicVertexArray<VertexT>::reserve(std::size_t const vertex_count, std::size_t const index_count) {
 	vertices.reserve(vertices.size() + vertex_count);
 	indices.reserve(indices.size() + index_count);
 }
 
-void VertexArray::clear() {
+template <typename VertexT>
+void BasicVertexArray<VertexT>::clear() {
 	vertices.clear();
 	indices.clear();
 }
 
-auto VertexArray::append(std::span<Vertex const> vertices, std::span<std::uint32_t const> indices) -> VertexArray& {
+template <typename VertexT>
+auto BasicVertexArray<VertexT>::append(std::span<VertexT const> vertices, std::span<std::uint32_t const> indices) -> BasicVertexArray& {
 	append_verts(*this, vertices, indices);
 	return *this;
 }
+
+template struct BasicVertexArray<Vertex>;
+template struct BasicVertexArray<PackedVertex>;
+
+void pack_vertices(std::vector<PackedVertex>& out, std::span<Vertex const> in) {
+	out.reserve(out.size() + in.size());
+	std::ranges::transform(in, std::back_inserter(out), &PackedVertex::pack);
+}
+
+void unpack_vertices(std::vector<Vertex>& out, std::span<PackedVertex const> in) {
+	out.reserve(out.size() + in.size());
+	std::ranges::transform(in, std::back_inserter(out), &PackedVertex::unpack);
+}
+
+void unpack_glyphs(std::vector<Vertex>& out, std::span<GlyphInstance const> in) {
+	out.reserve(out.size() + (in.size() * GlyphInstance::vertex_count_v));
+	for (auto const& glyph : in) { std::ranges::copy(glyph.to_vertices(), std::back_inserter(out)); }
+}
+
+void unpack_glyphs(std::vector<PackedVertex>& out, std::span<GlyphInstance const> in) {
+	// glyph UVs and colors are already quantized as PackedVertex stores them.
+	out.reserve(out.size() + (in.size() * GlyphInstance::vertex_count_v));
+	for (auto const& glyph : in) { std::ranges::transform(glyph.to_vertices(), std::back_inserter(out), &PackedVertex::pack); }
+}
+
+auto can_pack(std::span<Vertex const> vertices) -> bool { return std::ranges::all_of(vertices, &PackedVertex::can_pack); }
+
+auto store_vertices(VertexFormat const format, std::vector<Vertex>& vertices, std::vector<PackedVertex>& packed) -> VertexFormat {
+	if (format == VertexFormat::Packed && can_pack(vertices)) {
+		pack_vertices(packed, vertices);
+		vertices.clear();
+		return VertexFormat::Packed;
+	}
+	unpack_vertices(vertices, packed);
+	packed.clear();
+	return VertexFormat::Standard;
+}
 } // namespace le
@@ -1,8 +1,12 @@
 #include "le2d/vertex_bounds.hpp"
+#include <glm/common.hpp>
 #include <algorithm>
+#include <cmath>
 #include <limits>
 
-auto le::vertex_bounds(std::span<Vertex const> vertices, glm::mat4 const& model) -> kvf::Rect<> {
+namespace {
+template <typename VertexT>
+auto compute_bounds(std::span<VertexT const> vertices, glm::mat4 const& model) -> kvf::Rect<> {
 	if (vertices.empty()) { return {}; }
 	auto ret = kvf::Rect<>{};
 	ret.lt.x = ret.rb.y = std::numeric_limits<float>::max();
@@ -16,3 +20,39 @@ auto le::vertex_bounds(std::span<Vertex const> vertices, glm::mat4 const& model)
 	}
 	return ret;
 }
+} // namespace
+
+auto le::vertex_bounds(std::span<Vertex const> vertices, glm::mat4 const& model) -> kvf::Rect<> { return compute_bounds(vertices, model); }
+
+auto le::vertex_bounds(std::span<PackedVertex const> vertices, glm::mat4 const& model) -> kvf::Rect<> { return compute_bounds(vertices, model); }
+
+auto le::vertex_bounds(std::span<GlyphInstance const> glyphs, glm::mat4 const& model) -> kvf::Rect<> {
+	if (glyphs.empty()) { return {}; }
+	// glyph quads are axis-aligned in model space: bound them there, then transform the bounds.
+	auto ret = glyphs.front().get_rect();
+	for (auto const& glyph : glyphs.subspan(1)) {
+		ret.lt.x = std::min(ret.lt.x, glyph.lt.x);
+		ret.rb.y = std::min(ret.rb.y, glyph.rb.y);
+		ret.rb.x = std::max(ret.rb.x, glyph.rb.x);
+		ret.lt.y = std::max(ret.lt.y, glyph.lt.y);
+	}
+	return rect_bounds(ret, model);
+}
+
+auto le::rect_bounds(kvf::Rect<> const& rect, glm::mat4 const& model) -> kvf::Rect<> {
+	// transform the center, and the half extent by the absolute linear part.
+	auto const center = glm::vec2{model * glm::vec4{0.5f * (rect.lt + rect.rb), 0.0f, 1.0f}};
+	auto const half_extent = 0.5f * glm::abs(rect.rb - rect.lt);
+	auto const extent = glm::vec2{
+		(std::abs(model[0].x) * half_extent.x) + (std::abs(model[1].x) * half_extent.y),
+		(std::abs(model[0].y) * half_extent.x) + (std::abs(model[1].y) * half_extent.y),
+	};
+	return kvf::Rect<>{
+		.lt = {center.x - extent.x, center.y + extent.y},
+		.rb = {center.x + extent.x, center.y - extent.y},
+	};
+}
+
+auto le::intersects(kvf::Rect<> const& a, kvf::Rect<> const& b) -> bool {
+	return a.lt.x <= b.rb.x && b.lt.x <= a.rb.x && a.rb.y <= b.lt.y && b.rb.y <= a.lt.y;
+}
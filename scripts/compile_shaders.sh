@@ -7,6 +7,11 @@ spirv_dst=spir_v
 cpp_dst=lib/src/spirv
 vert=default.vert
 frag=default.frag
+compact_vert=compact.vert
+glyph_vert=glyph.vert
+sdf_frag=sdf.frag
+texture_table_vert=texture_table.vert
+texture_table_frag=texture_table.frag
 ext=.spv
 compiler=glslc
 formatter=clang-format
@@ -38,9 +43,19 @@ function embed() {
 
 compile $vert
 compile $frag
+compile $compact_vert
+compile $glyph_vert
+compile $sdf_frag
+compile $texture_table_vert
+compile $texture_table_frag
 
 embed $vert vert
 embed $frag frag
+embed $compact_vert compact_vert
+embed $glyph_vert glyph_vert
+embed $sdf_frag sdf_frag
+embed $texture_table_vert texture_table_vert
+embed $texture_table_frag texture_table_frag
 
 rm -rf $spirv_dst
 
@@ -0,0 +1,199 @@
+#include "fakes.hpp"
+#include "le2d/draw_queue.hpp"
+#include "le2d/draw_recorder.hpp"
+#include "test.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace le::test {
+namespace {
+// draws are identified by the red channel of their (pre-baked) tint.
+struct Draw {
+	int id{};
+	IShader const* shader{};
+	ITextureBase const* texture{};
+};
+
+// records draws in replay order.
+class FakeRenderer : public IRenderer {
+  public:
+	explicit FakeRenderer(IShader const& shader) : m_shader(&shader) {}
+
+	std::vector<Draw> draws{};
+
+  private:
+	[[nodiscard]] auto command_buffer() const -> vk::CommandBuffer final { return {}; }
+	[[nodiscard]] auto get_stats() const -> RenderStats const& final { return m_stats; }
+
+	auto begin_render(vk::CommandBuffer /*command_buffer*/, glm::ivec2 /*size*/, kvf::Color /*clear*/) -> bool final { return false; }
+	auto end_render() -> kvf::RenderTarget const& final { return m_render_target; }
+	void flush() final {}
+
+	[[nodiscard]] auto framebuffer_size() const -> glm::ivec2 final { return glm::ivec2{min_size_v}; }
+
+	[[nodiscard]] auto get_view() const -> Transform const& final { return m_view; }
+	void set_view(Transform const& view) final { m_view = view; }
+
+	[[nodiscard]] auto get_viewport() const -> Viewport const& final { return m_viewport; }
+	void set_viewport(Viewport const& viewport) final { m_viewport = viewport; }
+
+	void set_line_width(float /*width*/) final {}
+	[[nodiscard]] auto get_shader() const -> IShader const& final { return *m_shader; }
+	void set_shader(IShader const& shader) final { m_shader = &shader; }
+	void set_user_data(UserDrawData const& /*user_data*/) final {}
+
+	void draw(Primitive const& /*primitive*/, std::span<RenderInstance const> /*instances*/) final {}
+	void draw_baked(Primitive const& primitive, std::span<RenderInstance::Std430 const> instances) final {
+		draws.push_back(Draw{.id = int(instances.front().tint.x), .shader = m_shader, .texture = primitive.texture});
+	}
+	void draw_compact(Primitive const& /*primitive*/, std::span<RenderInstance::Compact const> /*instances*/) final {}
+
+	[[nodiscard]] auto fork() -> DrawRecorder& final { return m_recorder; }
+
+	[[nodiscard]] auto get_view_rect() const -> kvf::Rect<> final { return {}; }
+	void draw_culled(Primitive const& /*primitive*/, std::span<RenderInstance const> /*instances*/, kvf::Rect<> const& /*local_bounds*/) final {}
+
+	void begin_gpu_zone(std::string_view /*label*/) final {}
+	void end_gpu_zone() final {}
+	[[nodiscard]] auto get_gpu_timings() const -> std::span<GpuTiming const> final { return {}; }
+
+	[[nodiscard]] auto unprojector() const -> Unprojector final { return {}; }
+
+	IShader const* m_shader;
+	RenderStats m_stats{};
+	kvf::RenderTarget m_render_target{};
+	Transform m_view{};
+	Viewport m_viewport{};
+	DrawRecorder m_recorder{};
+};
+
+constexpr auto vertices_v = std::array{Vertex{}, Vertex{}, Vertex{}};
+
+struct Fixture {
+	void submit(int const id, DrawKey const& key, ITextureBase const* texture = {}) {
+		auto const primitive = Primitive{.vertices = vertices_v, .texture = texture};
+		auto const instance = RenderInstance::Std430{.transform = glm::mat4{1.0f}, .tint = glm::vec4{float(id), 0.0f, 0.0f, 1.0f}};
+		queue.submit_baked(primitive, {&instance, 1}, key);
+	}
+
+	[[nodiscard]] auto flush() -> std::vector<int> {
+		renderer.draws.clear();
+		queue.flush(renderer);
+		auto ret = std::vector<int>{};
+		for (auto const& draw : renderer.draws) { ret.push_back(draw.id); }
+		return ret;
+	}
+
+	FakeShader default_shader{};
+	FakeRenderer renderer{default_shader};
+	DrawQueue queue{};
+};
+
+LE_TEST(layers_are_ordered_with_negatives_first) {
+	auto fixture = Fixture{};
+	fixture.submit(0, DrawKey{.layer = 2});
+	fixture.submit(1, DrawKey{.layer = -1});
+	fixture.submit(2, DrawKey{.layer = std::int16_t{-32768}});
+	fixture.submit(3, DrawKey{.layer = 0});
+	fixture.submit(4, DrawKey{.layer = std::int16_t{32767}});
+	fixture.submit(5, DrawKey{.layer = -1});
+	LE_EXPECT(fixture.queue.get_size() == 6);
+	LE_EXPECT((fixture.flush() == std::vector{2, 1, 5, 3, 0, 4}));
+	LE_EXPECT(fixture.queue.is_empty());
+}
+
+LE_TEST(depth_is_ordered_within_a_layer) {
+	auto fixture = Fixture{};
+	fixture.submit(0, DrawKey{.depth = 0.5f});
+	fixture.submit(1, DrawKey{.depth = -0.25f});
+	fixture.submit(2, DrawKey{.depth = 0.0f});
+	fixture.submit(3, DrawKey{.depth = -1000.0f});
+	fixture.submit(4, DrawKey{.depth = 1e6f});
+	fixture.submit(5, DrawKey{.layer = -1, .depth = 1e9f});
+	LE_EXPECT((fixture.flush() == std::vector{5, 3, 1, 2, 0, 4}));
+}
+
+LE_TEST(textures_are_grouped_in_order_of_first_appearance) {
+	auto fixture = Fixture{};
+	auto const textures = std::array<FakeTexture, 2>{};
+	fixture.submit(0, {}, &textures[1]);
+	fixture.submit(1, {}, &textures[0]);
+	fixture.submit(2, {}, &textures[1]);
+	fixture.submit(3, {}, &textures[0]);
+	fixture.submit(4, {}, nullptr);
+	fixture.submit(5, {}, &textures[1]);
+	LE_EXPECT((fixture.flush() == std::vector{0, 2, 5, 1, 3, 4}));
+	LE_EXPECT(fixture.renderer.draws[0].texture == &textures[1]);
+	LE_EXPECT(fixture.renderer.draws[3].texture == &textures[0]);
+	LE_EXPECT(fixture.renderer.draws[5].texture == nullptr);
+}
+
+LE_TEST(shaders_are_grouped_and_restored) {
+	auto fixture = Fixture{};
+	auto const shader = FakeShader{};
+	auto const texture = FakeTexture{};
+	// shaders are grouped first, then textures in order of first appearance (null via draw 0 before texture via draw 1).
+	fixture.submit(0, DrawKey{});
+	fixture.submit(1, DrawKey{.shader = &shader}, &texture);
+	fixture.submit(2, DrawKey{.shader = &fixture.default_shader}, &texture);
+	fixture.submit(3, DrawKey{.shader = &shader});
+	LE_EXPECT((fixture.flush() == std::vector{0, 2, 3, 1}));
+	auto const& draws = fixture.renderer.draws;
+	LE_EXPECT(draws[0].shader == &fixture.default_shader && draws[1].shader == &fixture.default_shader);
+	LE_EXPECT(draws[2].shader == &shader && draws[3].shader == &shader);
+	LE_EXPECT(&static_cast<IRenderer const&>(fixture.renderer).get_shader() == &fixture.default_shader);
+}
+
+LE_TEST(radix_sort_matches_stable_sort) {
+	auto fixture = Fixture{};
+	auto const textures = std::array<FakeTexture, 3>{};
+	struct Submitted {
+		int id{};
+		std::int16_t layer{};
+		int texture{};
+		float depth{};
+	};
+	auto submitted = std::vector<Submitted>{};
+	auto texture_ids = std::array{-1, -1, -1};
+	auto next_texture_id = 0;
+	auto engine = std::mt19937{42};
+	auto layer_dist = std::uniform_int_distribution<int>{-300, 300};
+	auto texture_dist = std::uniform_int_distribution<std::size_t>{0, textures.size() - 1};
+	// integral depths are exact in the 24 bits of depth in the key, ties fall back to submission order.
+	auto depth_dist = std::uniform_int_distribution<int>{-50, 50};
+	for (int id = 0; id < 2000; ++id) {
+		auto const texture = texture_dist(engine);
+		if (texture_ids[texture] < 0) { texture_ids[texture] = next_texture_id++; }
+		auto const entry = Submitted{
+			.id = id,
+			.layer = std::int16_t(layer_dist(engine)),
+			.texture = texture_ids[texture],
+			.depth = float(depth_dist(engine)),
+		};
+		submitted.push_back(entry);
+		fixture.submit(id, DrawKey{.layer = entry.layer, .depth = entry.depth}, &textures[texture]);
+	}
+
+	std::ranges::stable_sort(submitted, [](Submitted const& a, Submitted const& b) {
+		if (a.layer != b.layer) { return a.layer < b.layer; }
+		if (a.texture != b.texture) { return a.texture < b.texture; }
+		return a.depth < b.depth;
+	});
+	auto expected = std::vector<int>{};
+	for (auto const& entry : submitted) { expected.push_back(entry.id); }
+	LE_EXPECT(fixture.flush() == expected);
+}
+
+LE_TEST(empty_draws_are_skipped) {
+	auto fixture = Fixture{};
+	auto const instance = RenderInstance::Std430{};
+	fixture.queue.submit_baked(Primitive{}, {&instance, 1});
+	fixture.queue.submit_baked(Primitive{.vertices = vertices_v}, {});
+	LE_EXPECT(fixture.queue.is_empty());
+	LE_EXPECT(fixture.flush().empty());
+}
+} // namespace
+} // namespace le::test
@@ -0,0 +1,33 @@
+#pragma once
+#include "le2d/resource/shader.hpp"
+#include "le2d/resource/texture.hpp"
+#include <cstdlib>
+
+namespace le::test {
+// texture without a GPU image, only its address is meaningful.
+class FakeTexture : public ITexture {
+  public:
+	[[nodiscard]] auto get_image() const -> vk::ImageView final { return {}; }
+	[[nodiscard]] auto get_size() const -> glm::ivec2 final { return glm::ivec2{1}; }
+
+	[[nodiscard]] auto get_sampler() const -> TextureSampler const& final { return m_sampler; }
+	void set_sampler(TextureSampler const& sampler) final { m_sampler = sampler; }
+
+	[[nodiscard]] auto descriptor_info() const -> vk::DescriptorImageInfo final { return {}; }
+
+	void overwrite(kvf::Bitmap const& /*bitmap*/) final {}
+	auto load_and_write(std::span<std::byte const> /*compressed_image*/) -> bool final { return false; }
+
+  private:
+	TextureSampler m_sampler{};
+};
+
+// shader without GPU pipelines, only its address is meaningful.
+class FakeShader : public IShader {
+  public:
+	[[nodiscard]] auto load(SpirV /*vertex*/, SpirV /*fragment*/) -> bool final { return false; }
+
+	[[nodiscard]] auto get_kvf_shader(VertexFormat /*format*/) const -> kvf::IGraphicsShader const& final { std::abort(); }
+	[[nodiscard]] auto get_instance_format() const -> InstanceFormat final { return InstanceFormat::Std430; }
+};
+} // namespace le::test
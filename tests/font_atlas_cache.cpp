@@ -0,0 +1,137 @@
+#include "detail/font_atlas_cache.hpp"
+#include "test.hpp"
+#include <filesystem>
+#include <format>
+#include <string_view>
+
+namespace le::test {
+namespace {
+namespace fs = std::filesystem;
+
+using detail::FontAtlasCache;
+
+constexpr auto directory_v = std::string_view{"font_atlases"};
+constexpr auto height_v = TextHeight{32};
+
+[[nodiscard]] auto to_bytes(std::string_view const text) -> std::span<std::byte const> { return std::as_bytes(std::span{text}); }
+
+// fresh (empty) root directory for a file loader.
+[[nodiscard]] auto make_root_dir(std::string_view const name) -> std::string {
+	auto const ret = fs::temp_directory_path() / "le2d-tests" / name;
+	fs::remove_all(ret);
+	fs::create_directories(ret);
+	return ret.generic_string();
+}
+
+[[nodiscard]] auto make_entry() -> FontAtlasCache::Entry {
+	auto ret = FontAtlasCache::Entry{};
+	for (auto const codepoint : {'A', 'g', ' '}) {
+		auto glyph = kvf::ttf::Glyph{};
+		glyph.codepoint = decltype(glyph.codepoint)(codepoint);
+		glyph.size = codepoint == ' ' ? glm::vec2{} : glm::vec2{10.0f, 14.0f};
+		glyph.left_top = {1.0f, float(codepoint)};
+		glyph.advance = {12.0f, 0.0f};
+		glyph.uv_rect = kvf::UvRect{.lt = {0.25f, 0.0f}, .rb = {0.5f, 0.75f}};
+		ret.glyphs.push_back(glyph);
+	}
+	ret.size = {5, 3};
+	for (int i = 0; i < ret.size.x * ret.size.y; ++i) { ret.pixels.push_back(std::byte(i * 17)); }
+	return ret;
+}
+
+[[nodiscard]] auto is_equal(kvf::ttf::Glyph const& a, kvf::ttf::Glyph const& b) -> bool {
+	return a.codepoint == b.codepoint && a.size == b.size && a.left_top == b.left_top && a.advance == b.advance && a.uv_rect.lt == b.uv_rect.lt &&
+		   a.uv_rect.rb == b.uv_rect.rb;
+}
+
+[[nodiscard]] auto is_equal(FontAtlasCache::Entry const& a, FontAtlasCache::Entry const& b) -> bool {
+	if (a.size != b.size || a.pixels != b.pixels || a.glyphs.size() != b.glyphs.size()) { return false; }
+	for (std::size_t i = 0; i < a.glyphs.size(); ++i) {
+		if (!is_equal(a.glyphs[i], b.glyphs[i])) { return false; }
+	}
+	return true;
+}
+
+[[nodiscard]] auto get_uri(std::uint64_t const hash, TextHeight const height) -> std::string {
+	return std::format("{}/{:016x}_{}.atlas", directory_v, hash, std::uint32_t(height));
+}
+
+LE_TEST(hash_is_fnv1a) {
+	LE_EXPECT(FontAtlasCache::hash_font({}) == 0xcbf29ce484222325);
+	LE_EXPECT(FontAtlasCache::hash_font(to_bytes("a")) == 0xaf63dc4c8601ec8c);
+	LE_EXPECT(FontAtlasCache::hash_font(to_bytes("foobar")) == 0x85944171f73967e8);
+	LE_EXPECT(FontAtlasCache::hash_font(to_bytes("ab")) != FontAtlasCache::hash_font(to_bytes("ba")));
+}
+
+LE_TEST(save_load_round_trip) {
+	auto const loader = FileDataLoader{make_root_dir("round_trip")};
+	auto cache = FontAtlasCache{&loader, std::string{directory_v}};
+	auto const hash = FontAtlasCache::hash_font(to_bytes("font bytes"));
+	cache.set_font_hash(hash);
+
+	auto loaded = FontAtlasCache::Entry{};
+	LE_EXPECT(!cache.load(loaded, height_v));
+
+	auto const entry = make_entry();
+	LE_EXPECT(cache.save(entry, height_v));
+	// keyed by font hash and height.
+	LE_EXPECT(fs::is_regular_file(loader.get_path(get_uri(hash, height_v))));
+	LE_EXPECT(cache.load(loaded, height_v));
+	LE_EXPECT(is_equal(loaded, entry));
+	LE_EXPECT(!cache.load(loaded, TextHeight{33}));
+}
+
+LE_TEST(save_rejects_mismatched_pixels) {
+	auto const loader = FileDataLoader{make_root_dir("mismatched_pixels")};
+	auto const cache = FontAtlasCache{&loader, std::string{directory_v}};
+	auto entry = make_entry();
+	entry.pixels.pop_back();
+	LE_EXPECT(!cache.save(entry, height_v));
+	LE_EXPECT(!FontAtlasCache{klib::Ptr<FileDataLoader const>{}, std::string{directory_v}}.save(make_entry(), height_v));
+}
+
+LE_TEST(load_rejects_mismatched_header) {
+	auto const loader = FileDataLoader{make_root_dir("mismatched_header")};
+	auto cache = FontAtlasCache{&loader, std::string{directory_v}};
+	auto const hash = FontAtlasCache::hash_font(to_bytes("font"));
+	cache.set_font_hash(hash);
+	LE_EXPECT(cache.save(make_entry(), height_v));
+	auto bytes = std::vector<std::byte>{};
+	LE_EXPECT(loader.try_load_bytes(bytes, get_uri(hash, height_v)));
+
+	auto loaded = FontAtlasCache::Entry{};
+	// the file name matches, but the header records another font.
+	auto const other_hash = FontAtlasCache::hash_font(to_bytes("other font"));
+	LE_EXPECT(loader.save_bytes(bytes, get_uri(other_hash, height_v)));
+	cache.set_font_hash(other_hash);
+	LE_EXPECT(!cache.load(loaded, height_v));
+
+	// the file name matches, but the header records another height.
+	cache.set_font_hash(hash);
+	LE_EXPECT(loader.save_bytes(bytes, get_uri(hash, TextHeight{64})));
+	LE_EXPECT(!cache.load(loaded, TextHeight{64}));
+
+	// truncated and overlong files.
+	auto const truncated = std::span{bytes}.first(bytes.size() - 1);
+	LE_EXPECT(loader.save_bytes(truncated, get_uri(hash, height_v)));
+	LE_EXPECT(!cache.load(loaded, height_v));
+	LE_EXPECT(loader.save_bytes(std::span{bytes}.first(8), get_uri(hash, height_v)));
+	LE_EXPECT(!cache.load(loaded, height_v));
+	bytes.push_back(std::byte{0});
+	LE_EXPECT(loader.save_bytes(bytes, get_uri(hash, height_v)));
+	LE_EXPECT(!cache.load(loaded, height_v));
+
+	// corrupt magic.
+	bytes.pop_back();
+	bytes.front() = std::byte{'X'};
+	LE_EXPECT(loader.save_bytes(bytes, get_uri(hash, height_v)));
+	LE_EXPECT(!cache.load(loaded, height_v));
+
+	// restored.
+	bytes.front() = std::byte{'L'};
+	LE_EXPECT(loader.save_bytes(bytes, get_uri(hash, height_v)));
+	LE_EXPECT(cache.load(loaded, height_v));
+	LE_EXPECT(is_equal(loaded, make_entry()));
+}
+} // namespace
+} // namespace le::test
@@ -0,0 +1,117 @@
+#include "le2d/instance_baker.hpp"
+#include "test.hpp"
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace le::test {
+namespace {
+// Transform::to_model() composes matrices from the orientation's angle, baking uses the orientation directly.
+constexpr auto epsilon_v = 1e-4f;
+
+[[nodiscard]] auto is_near(RenderInstance::Std430 const& a, RenderInstance::Std430 const& b) -> bool {
+	for (int i = 0; i < 4; ++i) {
+		if (!test::is_near(a.transform[i], b.transform[i], epsilon_v)) { return false; }
+	}
+	return test::is_near(a.tint, b.tint);
+}
+
+[[nodiscard]] auto make_instances(std::size_t const count) -> std::vector<RenderInstance> {
+	auto engine = std::mt19937{7};
+	auto position = std::uniform_real_distribution<float>{-1000.0f, 1000.0f};
+	auto radians = std::uniform_real_distribution<float>{-6.0f, 6.0f};
+	auto scale = std::uniform_real_distribution<float>{-4.0f, 4.0f};
+	auto channel = std::uniform_int_distribution<int>{0, 0xff};
+	auto ret = std::vector<RenderInstance>{};
+	ret.reserve(count);
+	for (std::size_t i = 0; i < count; ++i) {
+		auto instance = RenderInstance{};
+		instance.transform = Transform{
+			.position = {position(engine), position(engine)},
+			.orientation = nvec2::from_radians(radians(engine)),
+			.scale = {scale(engine), scale(engine)},
+		};
+		instance.tint.x = std::uint8_t(channel(engine));
+		instance.tint.y = std::uint8_t(channel(engine));
+		instance.tint.z = std::uint8_t(channel(engine));
+		instance.tint.w = std::uint8_t(channel(engine));
+		ret.push_back(instance);
+	}
+	return ret;
+}
+
+[[nodiscard]] auto matches_reference(std::span<RenderInstance::Std430 const> baked, std::span<RenderInstance const> instances, bool const linearize_tint)
+	-> bool {
+	if (baked.size() != instances.size()) { return false; }
+	for (std::size_t i = 0; i < instances.size(); ++i) {
+		if (!is_near(baked[i], instances[i].to_std430(linearize_tint))) { return false; }
+	}
+	return true;
+}
+
+LE_TEST(bake_matches_to_model) {
+	auto const instances = make_instances(256);
+	auto baked = std::vector<RenderInstance::Std430>(instances.size());
+	bake_instances(baked, instances);
+	LE_EXPECT(matches_reference(baked, instances, true));
+	bake_instances(baked, instances, false);
+	LE_EXPECT(matches_reference(baked, instances, false));
+}
+
+LE_TEST(bake_streams_matches_to_model) {
+	auto const instances = make_instances(128);
+	auto positions = std::vector<glm::vec2>{};
+	auto orientations = std::vector<glm::vec2>{};
+	auto scales = std::vector<glm::vec2>{};
+	auto tints = std::vector<kvf::Color>{};
+	for (auto const& instance : instances) {
+		positions.push_back(instance.transform.position);
+		orientations.push_back(instance.transform.orientation);
+		scales.push_back(instance.transform.scale);
+		tints.push_back(instance.tint);
+	}
+	auto baked = std::vector<RenderInstance::Std430>(instances.size());
+	bake_instances(baked, RenderInstanceStreams{.positions = positions, .orientations = orientations, .scales = scales, .tints = tints});
+	LE_EXPECT(matches_reference(baked, instances, true));
+
+	// omitted streams fall back to the defaults of RenderInstance.
+	bake_instances(baked, RenderInstanceStreams{.positions = positions});
+	auto defaults = std::vector<RenderInstance>(instances.size());
+	for (std::size_t i = 0; i < defaults.size(); ++i) { defaults[i].transform.position = positions[i]; }
+	LE_EXPECT(matches_reference(baked, defaults, true));
+}
+
+LE_TEST(bake_compact_matches_to_std430) {
+	auto const instances = make_instances(64);
+	auto compact = std::vector<RenderInstance::Compact>{};
+	for (auto const& instance : instances) { compact.push_back(instance.to_compact()); }
+	auto baked = std::vector<RenderInstance::Std430>(compact.size());
+	bake_instances(baked, compact);
+	for (std::size_t i = 0; i < compact.size(); ++i) { LE_EXPECT(is_near(baked[i], compact[i].to_std430())); }
+	LE_EXPECT(matches_reference(baked, instances, true));
+}
+
+LE_TEST(parallel_bake_matches_to_model) {
+	// odd count and a small threshold: several chunks, the last one partial.
+	auto const instances = make_instances(1001);
+	auto baker = IInstanceBaker::create(InstanceBakerCreateInfo{.thread_count = klib::task::ThreadCount{4}, .min_parallel_count = 100});
+	auto baked = std::vector<RenderInstance::Std430>(instances.size());
+	baker->bake(baked, instances);
+	LE_EXPECT(matches_reference(baked, instances, true));
+
+	auto positions = std::vector<glm::vec2>{};
+	auto tints = std::vector<kvf::Color>{};
+	for (auto const& instance : instances) {
+		positions.push_back(instance.transform.position);
+		tints.push_back(instance.tint);
+	}
+	baker->bake(baked, RenderInstanceStreams{.positions = positions, .tints = tints}, false);
+	auto expected = std::vector<RenderInstance>(instances.size());
+	for (std::size_t i = 0; i < expected.size(); ++i) {
+		expected[i].transform.position = positions[i];
+		expected[i].tint = tints[i];
+	}
+	LE_EXPECT(matches_reference(baked, expected, false));
+}
+} // namespace
+} // namespace le::test
@@ -0,0 +1,187 @@
+#include "fakes.hpp"
+#include "le2d/text/line_input.hpp"
+#include "test.hpp"
+#include <array>
+#include <random>
+#include <string>
+
+namespace le::test {
+namespace {
+// monospace-free atlas with pair kerning and a zero size (quadless) space, covering ASCII.
+class FakeAtlas : public IFontAtlas {
+  public:
+	FakeAtlas() { rebuild(0.0f); }
+
+	// changes every glyph's metrics (like a rebuilt atlas) and bumps the generation.
+	void rebuild(float const extra_advance) {
+		for (std::size_t i = 0; i < m_glyphs.size(); ++i) {
+			auto& glyph = m_glyphs[i];
+			glyph.codepoint = decltype(glyph.codepoint)(i);
+			glyph.size = i == ' ' ? glm::vec2{} : glm::vec2{8.0f, 10.0f + float(i % 3)};
+			glyph.left_top = {float(i % 2), 10.0f};
+			glyph.advance = {6.0f + float(i % 5) + extra_advance, 0.0f};
+			auto const u = float(i) / float(m_glyphs.size());
+			glyph.uv_rect = kvf::UvRect{.lt = {u, 0.0f}, .rb = {u + 0.005f, 0.5f}};
+		}
+		++m_generation;
+	}
+
+	[[nodiscard]] auto get_glyph(char32_t const codepoint) const -> Glyph const* final {
+		return std::size_t(codepoint) < m_glyphs.size() ? &m_glyphs[std::size_t(codepoint)] : nullptr;
+	}
+	[[nodiscard]] auto get_texture() const -> ITexture const& final { return m_texture; }
+	[[nodiscard]] auto get_height() const -> TextHeight final { return TextHeight::Default; }
+	[[nodiscard]] auto get_generation() const -> std::uint64_t final { return m_generation; }
+
+	auto push_layouts(std::vector<GlyphLayout>& out, std::string_view const text, float const /*n_line_height*/, bool const /*use_tofu*/) const
+		-> glm::vec2 final {
+		auto baseline = glm::vec2{};
+		auto previous = char{};
+		for (auto const c : text) {
+			if (previous != char{}) { baseline.x += get_kerning(previous, c); }
+			auto const* glyph = get_glyph(char32_t(static_cast<unsigned char>(c)));
+			auto layout = GlyphLayout{};
+			layout.glyph = glyph;
+			layout.baseline = baseline;
+			out.push_back(layout);
+			baseline.x += glyph->advance.x;
+			previous = c;
+		}
+		return baseline;
+	}
+
+  private:
+	// non-zero for most pairs, so that relayout must restart before the edit.
+	[[nodiscard]] static auto get_kerning(char const left, char const right) -> float { return -0.5f * float(((left * 31) + right) % 4); }
+
+	std::array<Glyph, 128> m_glyphs{};
+	FakeTexture m_texture{};
+	std::uint64_t m_generation{};
+};
+
+class FakeFont : public IFont {
+  public:
+	auto load_face(std::vector<std::byte> /*font_bytes*/) -> bool final { return false; }
+
+	[[nodiscard]] auto get_name() const -> klib::CString final { return "fake"; }
+
+	void set_atlas_cache(klib::Ptr<FileDataLoader const> /*loader*/, std::string /*directory*/) final {}
+
+	void set_page(klib::Ptr<IFontPage> /*page*/) final {}
+
+	[[nodiscard]] auto get_atlas(TextHeight /*height*/) -> IFontAtlas& final { return atlas; }
+	[[nodiscard]] auto get_distance_field_atlas() -> IFontAtlas& final { return atlas; }
+	[[nodiscard]] auto get_scaled_atlas(float /*height*/) -> ScaledAtlas final { return ScaledAtlas{.atlas = &atlas}; }
+
+	void prewarm(std::span<TextHeight const> /*heights*/) final {}
+	[[nodiscard]] auto is_ready(TextHeight /*height*/) const -> bool final { return true; }
+
+	FakeAtlas atlas{};
+};
+
+[[nodiscard]] auto is_near(glm::vec2 const a, glm::vec2 const b) -> bool { return test::is_near(a.x, b.x) && test::is_near(a.y, b.y); }
+
+// compares input against a full relayout of its string (with the same cursor).
+[[nodiscard]] auto matches_full_relayout(FakeFont& font, LineInput const& input) -> bool {
+	auto full = LineInput{&font};
+	full.set_string(std::string{input.get_string()});
+	full.set_cursor(input.get_cursor());
+
+	if (full.get_string() != input.get_string() || full.get_cursor() != input.get_cursor()) { return false; }
+	if (!is_near(full.get_size(), input.get_size()) || !test::is_near(full.get_cursor_x(), input.get_cursor_x())) { return false; }
+
+	auto const expected_layouts = full.get_glyph_layouts();
+	auto const layouts = input.get_glyph_layouts();
+	if (layouts.size() != expected_layouts.size()) { return false; }
+	for (std::size_t i = 0; i < layouts.size(); ++i) {
+		if (layouts[i].glyph != expected_layouts[i].glyph || !is_near(layouts[i].baseline, expected_layouts[i].baseline)) { return false; }
+	}
+
+	auto const expected_glyphs = full.to_primitive().glyphs;
+	auto const glyphs = input.to_primitive().glyphs;
+	if (glyphs.size() != expected_glyphs.size()) { return false; }
+	for (std::size_t i = 0; i < glyphs.size(); ++i) {
+		auto const& a = glyphs[i];
+		auto const& b = expected_glyphs[i];
+		if (!is_near(a.lt, b.lt) || !is_near(a.rb, b.rb) || a.uv != b.uv || a.color != b.color) { return false; }
+	}
+	return true;
+}
+
+LE_TEST(edits_match_full_relayout) {
+	auto font = FakeFont{};
+	auto input = LineInput{&font};
+	LE_EXPECT(matches_full_relayout(font, input));
+
+	input.append("AVAToy");
+	LE_EXPECT(matches_full_relayout(font, input));
+	input.append(" Wave");
+	LE_EXPECT(matches_full_relayout(font, input));
+
+	// insert in the middle and at the front.
+	input.set_cursor(3);
+	input.write('x');
+	LE_EXPECT(matches_full_relayout(font, input));
+	input.set_cursor(0);
+	input.write('T');
+	LE_EXPECT(matches_full_relayout(font, input));
+
+	// delete around spaces (which have no quads).
+	input.set_cursor(8);
+	input.backward_delete();
+	LE_EXPECT(matches_full_relayout(font, input));
+	input.forward_delete();
+	LE_EXPECT(matches_full_relayout(font, input));
+	input.backward_word();
+	input.write(' ');
+	LE_EXPECT(matches_full_relayout(font, input));
+
+	// deletes at the ends are no-ops.
+	input.set_cursor(0);
+	input.backward_delete();
+	LE_EXPECT(matches_full_relayout(font, input));
+	input.set_cursor(int(input.get_string().size()));
+	input.forward_delete();
+	LE_EXPECT(matches_full_relayout(font, input));
+
+	input.set_string("fresh");
+	LE_EXPECT(matches_full_relayout(font, input));
+	while (!input.get_string().empty()) { input.backward_delete(); }
+	LE_EXPECT(matches_full_relayout(font, input));
+	input.write('y');
+	LE_EXPECT(matches_full_relayout(font, input));
+}
+
+LE_TEST(atlas_rebuild_relayouts_kept_glyphs) {
+	auto font = FakeFont{};
+	auto input = LineInput{&font};
+	input.set_string("kept glyphs");
+	font.atlas.rebuild(1.5f);
+	input.set_cursor(6);
+	input.write('!');
+	LE_EXPECT(matches_full_relayout(font, input));
+}
+
+LE_TEST(random_edits_match_full_relayout) {
+	constexpr auto charset_v = std::string_view{"AVTWaoy .,"};
+	auto font = FakeFont{};
+	auto input = LineInput{&font};
+	auto engine = std::mt19937{1234};
+	auto op = std::uniform_int_distribution<int>{0, 5};
+	auto ch = std::uniform_int_distribution<std::size_t>{0, charset_v.size() - 1};
+	auto failures = 0;
+	for (int i = 0; i < 1000; ++i) {
+		switch (op(engine)) {
+		case 0:
+		case 1: input.write(charset_v[ch(engine)]); break;
+		case 2: input.backward_delete(); break;
+		case 3: input.forward_delete(); break;
+		case 4: input.move_cursor(std::uniform_int_distribution<int>{-4, 4}(engine)); break;
+		default: input.append(charset_v.substr(ch(engine), 2)); break;
+		}
+		if (!matches_full_relayout(font, input)) { ++failures; }
+	}
+	LE_EXPECT(failures == 0);
+}
+} // namespace
+} // namespace le::test
@@ -0,0 +1,56 @@
+#include "le2d/vertex.hpp"
+#include "test.hpp"
+#include <array>
+
+namespace le::test {
+namespace {
+// half a quantization step.
+constexpr auto uv_epsilon_v = 0.5f / 65535.0f;
+constexpr auto color_epsilon_v = 0.5f / 255.0f;
+
+[[nodiscard]] auto is_within(float const a, float const b, float const epsilon) -> bool { return a >= b - epsilon && a <= b + epsilon; }
+
+LE_TEST(pack_round_trip) {
+	auto const vertices = std::array{
+		Vertex{.position = {-123.5f, 4096.25f}, .color = {0.0f, 0.25f, 0.5f, 1.0f}, .uv = {0.0f, 1.0f}},
+		Vertex{.position = {1e-3f, -1e6f}, .color = {0.1f, 0.2f, 0.3f, 0.4f}, .uv = {0.333f, 0.667f}},
+		Vertex{.position = {}, .color = {1.0f, 1.0f, 1.0f, 0.0f}, .uv = {0.5f, 1.0f / 65535.0f}},
+	};
+	for (auto const& vertex : vertices) {
+		LE_EXPECT(PackedVertex::can_pack(vertex));
+		auto const unpacked = PackedVertex::pack(vertex).unpack();
+		// positions are stored as-is.
+		LE_EXPECT(unpacked.position == vertex.position);
+		for (int i = 0; i < 2; ++i) { LE_EXPECT(is_within(unpacked.uv[i], vertex.uv[i], uv_epsilon_v)); }
+		for (int i = 0; i < 4; ++i) { LE_EXPECT(is_within(unpacked.color[i], vertex.color[i], color_epsilon_v)); }
+	}
+}
+
+LE_TEST(pack_is_exact_at_bounds) {
+	auto const packed = PackedVertex::pack(Vertex{.color = {0.0f, 1.0f, 0.0f, 1.0f}, .uv = {0.0f, 1.0f}});
+	LE_EXPECT(packed.uv == glm::u16vec2(0, 0xffff));
+	LE_EXPECT(packed.color == glm::u8vec4(0, 0xff, 0, 0xff));
+	auto const unpacked = packed.unpack();
+	LE_EXPECT(unpacked.uv == glm::vec2(0.0f, 1.0f));
+	LE_EXPECT(unpacked.color == glm::vec4(0.0f, 1.0f, 0.0f, 1.0f));
+}
+
+LE_TEST(pack_repacks_identically) {
+	auto const packed = PackedVertex::pack(Vertex{.position = {3.0f, -7.0f}, .color = {0.3f, 0.6f, 0.9f, 0.5f}, .uv = {0.123f, 0.987f}});
+	auto const repacked = PackedVertex::pack(packed.unpack());
+	LE_EXPECT(repacked.position == packed.position);
+	LE_EXPECT(repacked.uv == packed.uv);
+	LE_EXPECT(repacked.color == packed.color);
+}
+
+LE_TEST(out_of_range_is_clamped) {
+	auto const vertex = Vertex{.color = {-1.0f, 2.0f, 0.5f, 1.5f}, .uv = {-0.5f, 1.5f}};
+	LE_EXPECT(!PackedVertex::can_pack(vertex));
+	LE_EXPECT(!PackedVertex::can_pack(Vertex{.uv = {1.0001f, 0.0f}}));
+	LE_EXPECT(!PackedVertex::can_pack(Vertex{.uv = {0.0f, -0.0001f}}));
+	auto const packed = PackedVertex::pack(vertex);
+	LE_EXPECT(packed.uv == glm::u16vec2(0, 0xffff));
+	LE_EXPECT(packed.color.x == 0 && packed.color.y == 0xff && packed.color.w == 0xff);
+}
+} // namespace
+} // namespace le::test
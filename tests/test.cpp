@@ -0,0 +1,60 @@
+#include "test.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <print>
+#include <vector>
+
+namespace le::test {
+namespace {
+struct Test {
+	std::string_view name{};
+	TestFunc func{};
+};
+
+struct State {
+	std::vector<Test> tests{};
+	int failures{};
+};
+
+// function-local to be usable from static initializers of other translation units.
+auto get_state() -> State& {
+	static auto ret = State{};
+	return ret;
+}
+} // namespace
+
+auto add_test(std::string_view const name, TestFunc const func) -> bool {
+	get_state().tests.push_back(Test{.name = name, .func = func});
+	return true;
+}
+
+auto expect(bool const pred, std::string_view const expr, std::source_location const& location) -> bool {
+	if (pred) { return true; }
+	++get_state().failures;
+	std::println(stderr, "  FAILED: {}\n    {}:{}", expr, location.file_name(), location.line());
+	return false;
+}
+
+auto run_tests() -> int {
+	auto& state = get_state();
+	auto failed = 0;
+	for (auto const& test : state.tests) {
+		auto const failures = state.failures;
+		std::println("[{}]", test.name);
+		test.func();
+		if (state.failures > failures) { ++failed; }
+	}
+	std::println("{}/{} passed", state.tests.size() - std::size_t(failed), state.tests.size());
+	return failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+auto is_near(float const a, float const b, float const epsilon) -> bool { return std::abs(a - b) <= epsilon * std::max(1.0f, std::abs(b)); }
+
+auto is_near(glm::vec4 const& a, glm::vec4 const& b, float const epsilon) -> bool {
+	return is_near(a.x, b.x, epsilon) && is_near(a.y, b.y, epsilon) && is_near(a.z, b.z, epsilon) && is_near(a.w, b.w, epsilon);
+}
+} // namespace le::test
+
+auto main() -> int { return le::test::run_tests(); }
@@ -0,0 +1,27 @@
+#pragma once
+#include <glm/vec4.hpp>
+#include <source_location>
+#include <string_view>
+
+namespace le::test {
+using TestFunc = void (*)();
+
+// registers func to be run by run_tests(), returns true for use in static initializers (see LE_TEST).
+auto add_test(std::string_view name, TestFunc func) -> bool;
+
+// records a failure of the current test (and logs its location) if pred is false.
+auto expect(bool pred, std::string_view expr, std::source_location const& location = std::source_location::current()) -> bool;
+
+// runs all registered tests, returns the process exit code.
+[[nodiscard]] auto run_tests() -> int;
+
+[[nodiscard]] auto is_near(float a, float b, float epsilon = 1e-5f) -> bool;
+[[nodiscard]] auto is_near(glm::vec4 const& a, glm::vec4 const& b, float epsilon = 1e-5f) -> bool;
+} // namespace le::test
+
+#define LE_TEST(name)                                                                                                                                          \
+	static void name();                                                                                                                                        \
+	[[maybe_unused]] static auto const name##_registered_ = ::le::test::add_test(#name, &name);                                                                \
+	static void name()
+
+#define LE_EXPECT(pred) ::le::test::expect(static_cast<bool>(pred), #pred)